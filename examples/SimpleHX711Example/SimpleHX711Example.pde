@@ -1,12 +1,17 @@
 #include "Arduino.h"
 #include <EEPROM.h>
 #include <SimpleHX711.h>
+#include <HX711Reporter.h>
 
 
 /*----Setup a SingleHX711 instance and pass our pins ----*/
 
 SimpleHX711 scale(A0, A1); // ,SimpleHX711::gain64);
 
+/*----Report only changes larger than 2 or every 10 seconds ----*/
+
+HX711Reporter reporter(2, 1, 10000);
+
 /*----Recognizable names for the EEPROM addresses ----*/
 
 enum EEPROMAdr {
@@ -17,13 +22,22 @@ enum EEPROMAdr {
 	eeTare = 5,				// 4 byte for tare
 	eeAdjuster = 9,			// 4 bytes for adjuster
 	eeRate = 13,			// 2 bytes for the rate
+	eeZero = 15,			// 4 bytes for the gross zero
 };
 
+/*
+ * OldIdentifier marks settings saved before the gross zero was,
+ * they still load with a zero of 0
+ */
+const int16_t OldIdentifier = 12345;
+const int16_t Identifier = 12346;
+
 /*----Declare variables ----*/
 uint32_t LastScaleUpdate, LastPrintDot; //LastSuccessfulRead,
 uint16_t UpdateRate = 1000;
 char buff[80];
 bool Verbose = true;
+bool OnChange = false;
 
 // Helper function to call a function at a certain interval
 
@@ -98,8 +112,15 @@ void setup() {
 }
 
 void loop() {
-	doFunctionAtInterval(outputScale, &LastScaleUpdate, UpdateRate);
-	scale.read();
+	if (OnChange) {
+		// output only when the scale changed or the heartbeat expired
+		if (scale.read() && scale.getStatus() == SimpleHX711::valid
+				&& reporter.check(scale.getAdjusted(true), millis()))
+			outputScale();
+	} else {
+		doFunctionAtInterval(outputScale, &LastScaleUpdate, UpdateRate);
+		scale.read();
+	}
 	serialListen();
 }
 
@@ -138,6 +159,11 @@ void serialListen() {
 			scale.tare(true);
 			Serial.println(F("Scale set to zero"));
 			break;
+		case 'z':
+			// zero: sets the gross zero, the tare is kept
+			scale.zero(true);
+			Serial.println(F("Gross zero set"));
+			break;
 		case 's':
 			// set: s1000 adjust the output to 1000
 			input = Serial.parseInt();
@@ -200,7 +226,7 @@ void serialListen() {
 			}
 			break;
 		case 'e':
-			// store alpha, gain, rate, tare and adjuster in eeprom
+			// store alpha, gain, rate, zero, tare and adjuster in eeprom
 			saveToEEPROM();
 			Serial.println(F("EEPROM updated"));
 			break;
@@ -214,6 +240,10 @@ void serialListen() {
 			// toggles verbose output
 			Verbose = !Verbose;
 			break;
+		case 'c':
+			// toggles between output on change and output at the update rate
+			OnChange = !OnChange;
+			break;
 		case 'h':
 			// print the commands
 			printHelp();
@@ -224,10 +254,13 @@ void serialListen() {
 }
 
 bool loadFromEEPROM() {
-	if (EEPROMread16(eeIndentifier) == 12345) {
+	int16_t identifier = EEPROMread16(eeIndentifier);
+	if (identifier == Identifier || identifier == OldIdentifier) {
 		scale.setAlpha(EEPROM.read(eeAlpha));
 		scale.setReadsUntilValid(EEPROM.read(eeReadsUntilValid));
 		scale.setGain(SimpleHX711::gain(EEPROM.read(eeGain)));
+		// the tare is relative to the gross zero
+		scale.setZero(identifier == Identifier ? EEPROMread32(eeZero) : 0);
 		scale.setTare(EEPROMread32(eeTare));
 		scale.setAdjuster(EEPROMread32(eeAdjuster));
 		UpdateRate = EEPROMread16(eeRate);
@@ -236,10 +269,11 @@ bool loadFromEEPROM() {
 }
 
 void saveToEEPROM() {
-	EEPROMupdate16(eeIndentifier, 12345);
+	EEPROMupdate16(eeIndentifier, Identifier);
 	EEPROM.update(eeAlpha, scale.getAlpha());
 	EEPROM.update(eeReadsUntilValid, scale.getReadsUntilValid());
 	EEPROM.update(eeGain, scale.getGain());
+	EEPROMupdate32(eeZero, scale.getZero());
 	EEPROMupdate32(eeTare, scale.getTare());
 	EEPROMupdate32(eeAdjuster, scale.getAdjuster());
 	EEPROMupdate16(eeRate, UpdateRate);
@@ -255,6 +289,8 @@ void printSettings() {
 	Serial.println(scale.getReadsUntilValid());
 	Serial.print(F("Gain set to: "));
 	Serial.println(scale.getGain());
+	Serial.print(F("Zero set to: "));
+	Serial.println(scale.getZero());
 	Serial.print(F("Tare set to: "));
 	Serial.println(scale.getTare());
 	Serial.print(F("Ajuster set to: "));
@@ -265,12 +301,14 @@ void printSettings() {
 
 void printHelp() {
 	Serial.println(F("\nt = tare, sets the output to zero"));
+	Serial.println(F("z = zero, sets the gross zero"));
 	Serial.println(F("s = set, s1000 sets the output to 1000"));
 	Serial.println(F("d = power down, powers the chip down"));
 	Serial.println(F("u = power up, powers the chip up"));
-	Serial.println(F("e = EEPROM, store alpha, gain, rate, tare and adjuster in eeprom"));
+	Serial.println(F("e = EEPROM, store alpha, gain, rate, zero, tare and adjuster in eeprom"));
 	Serial.println(F("p = print settings"));
 	Serial.println(F("v = verbose toggle, toggles between verbose and simple output"));
+	Serial.println(F("c = change toggle, toggles between output on change and at the update rate"));
 	Serial.println(F("D = Display rate, d1000 set the update rate to 1000 ms"));
 	Serial.println(F("r = reads, r10 set the amount of reads to ten after a reset"));
 	Serial.println(F("g = gain, g64 set the gain to 64"));
@@ -0,0 +1,71 @@
+#ifndef ARDUINO_H
+#define ARDUINO_H
+
+/*
+ * The part of the Arduino API used by SimpleHX711, for building it on a
+ * host against HX711SimChip. Only for the host tools, never put this
+ * directory in the include path of a sketch.
+ *
+ * Copyright (C) 2016 Edwin Croissant
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * See the README.md file for additional information.
+ */
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef uint8_t byte;
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define LSBFIRST 0
+#define MSBFIRST 1
+
+#define PI 3.1415926535897932384626433832795
+#define constrain(amt,low,high) ((amt)<(low)?(low):((amt)>(high)?(high):(amt)))
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+unsigned long millis();
+unsigned long micros();
+void delayMicroseconds(unsigned int us);
+void noInterrupts();
+void interrupts();
+
+class Print {
+public:
+	virtual ~Print() {
+	}
+	virtual size_t write(uint8_t byte) = 0;
+	virtual size_t write(const uint8_t *buffer, size_t size) {
+		size_t i;
+		for (i = 0; i < size; ++i)
+			write(buffer[i]);
+		return size;
+	}
+	virtual int availableForWrite() {
+		return 0;
+	}
+};
+
+#endif //  ARDUINO_H
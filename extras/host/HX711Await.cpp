@@ -0,0 +1,244 @@
+#include <sys/epoll.h>
+#include <time.h>
+#include <unistd.h>
+#include "HX711Await.h"
+
+/*
+ * a waiting task gives read() another try after this many ns
+ * so it can report timedOut when the chip never becomes ready
+ */
+#define HX711AWAIT_RETRY 100000000ULL
+
+static uint64_t nanos() {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return uint64_t(now.tv_sec) * 1000000000 + now.tv_nsec;
+}
+
+/*
+ * Makes an executor, call begin before making the scales
+ */
+
+HX711Executor::HX711Executor() {
+	_epoll = -1;
+	_wakeups = 0;
+}
+
+HX711Executor::~HX711Executor() {
+	end();
+}
+
+/*
+ * makes the epoll instance, returns false on failure
+ */
+bool HX711Executor::begin() {
+	end();
+	_epoll = epoll_create1(EPOLL_CLOEXEC);
+	return _epoll >= 0;
+}
+
+/*
+ * destroys the tasks that did not finish
+ */
+void HX711Executor::end() {
+	for (auto task : _tasks)
+		task.destroy();
+	_tasks.clear();
+	_scales.clear();
+	if (_epoll >= 0)
+		close(_epoll);
+	_epoll = -1;
+}
+
+/*
+ * starts the task, it runs until its first co_await
+ */
+void HX711Executor::spawn(HX711Task task) {
+	std::coroutine_handle<HX711Task::promise_type> handle = task.release();
+
+	_tasks.push_back(handle);
+	handle.resume();
+}
+
+/*
+ * runs until all tasks are done
+ */
+void HX711Executor::run() {
+	struct epoll_event events[HX711AWAIT_SCALES];
+	uint64_t now;
+	int timeout, ready, i;
+	bool waiting;
+	size_t task;
+
+	while (!_tasks.empty()) {
+		/*
+		 * sleep until a scale is ready or the earliest retry
+		 */
+		now = nanos();
+		timeout = -1;
+		waiting = false;
+		for (auto scale : _scales) {
+			if (!scale->_awaiter)
+				continue;
+			waiting = true;
+			i = scale->_deadline > now ?
+					(scale->_deadline - now + 999999) / 1000000 : 0;
+			if (timeout < 0 || i < timeout)
+				timeout = i;
+		}
+		/*
+		 * tasks that wait for nothing will never finish
+		 */
+		if (!waiting)
+			break;
+		ready = epoll_wait(_epoll, events, HX711AWAIT_SCALES, timeout);
+		++_wakeups;
+		now = nanos();
+		for (i = 0; i < ready; ++i)
+			static_cast<HX711AwaitScale*>(events[i].data.ptr)->ready(now);
+		for (auto scale : _scales)
+			if (scale->_awaiter && scale->_deadline <= now)
+				scale->ready(now);
+
+		for (task = 0; task < _tasks.size();) {
+			if (_tasks[task].done()) {
+				_tasks[task].destroy();
+				_tasks[task] = _tasks.back();
+				_tasks.pop_back();
+			} else
+				++task;
+		}
+	}
+}
+
+/*
+ * returns the amount of times the executor woke up
+ */
+uint64_t HX711Executor::getWakeups() {
+	return _wakeups;
+}
+
+bool HX711Executor::watch(HX711AwaitScale *scale) {
+	struct epoll_event event;
+
+	if (_epoll < 0 || _scales.size() >= HX711AWAIT_SCALES)
+		return false;
+	event.events = EPOLLIN;
+	event.data.ptr = scale;
+	if (epoll_ctl(_epoll, EPOLL_CTL_ADD, scale->getReadyFd(), &event) < 0)
+		return false;
+	_scales.push_back(scale);
+	return true;
+}
+
+/*
+ * Makes a scale the tasks on the executor can await, the scale is
+ * only read by the tasks
+ */
+
+HX711AwaitScale::HX711AwaitScale(HX711Executor &executor, SimpleHX711 &scale,
+		int readyFd) :
+		_executor(executor), _scale(scale) {
+	_fd = readyFd;
+	_awaiter = nullptr;
+	_deadline = 0;
+	_executor.watch(this);
+}
+
+/*
+ * co_await scale.nextSample() suspends the task until read() is done,
+ * it returns the status: valid, or poweredDown or timedOut, which end the
+ * wait at once so check for them before awaiting again
+ */
+HX711AwaitScale::sampleAwaiter HX711AwaitScale::nextSample() {
+	return sampleAwaiter { *this };
+}
+
+bool HX711AwaitScale::sampleAwaiter::await_ready() {
+	return scale._scale.read();
+}
+
+void HX711AwaitScale::sampleAwaiter::await_suspend(
+		std::coroutine_handle<> awaiter) {
+	scale._awaiter = awaiter;
+	scale._deadline = nanos() + HX711AWAIT_RETRY;
+}
+
+SimpleHX711::status HX711AwaitScale::sampleAwaiter::await_resume() {
+	return scale._scale.getStatus();
+}
+
+/*
+ * co_await scale.stable(tolerance, count) suspends the task until count
+ * readings in a row of getAdjusted are within tolerance of each other.
+ * It returns true when stable, false when limit readings pass first
+ * or the chip is powered down or disconnected. limit is optional and
+ * defaults to 100
+ */
+HX711Task HX711AwaitScale::stable(int32_t tolerance, uint8_t count,
+		uint16_t limit) {
+	SimpleHX711::status status;
+	int32_t value, low = 0, high = 0;
+	uint8_t inRow = 0;
+	uint16_t i;
+
+	for (i = 0; i < limit; ++i) {
+		status = co_await nextSample();
+		if (status != SimpleHX711::valid)
+			co_return false;
+		value = _scale.getAdjusted();
+		if (!inRow || value - low > tolerance || high - value > tolerance) {
+			/*
+			 * start a new run with this reading
+			 */
+			low = value;
+			high = value;
+			inRow = 1;
+		} else {
+			if (value < low)
+				low = value;
+			if (value > high)
+				high = value;
+			++inRow;
+		}
+		if (inRow >= count)
+			co_return true;
+	}
+	co_return false;
+}
+
+/*
+ * returns the scale
+ */
+SimpleHX711 &HX711AwaitScale::getScale() {
+	return _scale;
+}
+
+/*
+ * returns the file descriptor that signals a ready conversion
+ */
+int HX711AwaitScale::getReadyFd() {
+	return _fd;
+}
+
+/*
+ * the ready event fired or the retry time passed, read the scale
+ * and resume the waiting task when done
+ */
+void HX711AwaitScale::ready(uint64_t now) {
+	uint8_t buffer[256];
+	std::coroutine_handle<> awaiter;
+
+	while (read(_fd, buffer, sizeof(buffer)) > 0)
+		;
+	if (!_awaiter)
+		return;
+	if (!_scale.read()) {
+		if (_deadline <= now)
+			_deadline = now + HX711AWAIT_RETRY;
+		return;
+	}
+	awaiter = _awaiter;
+	_awaiter = nullptr;
+	awaiter.resume();
+}
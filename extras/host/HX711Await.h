@@ -0,0 +1,163 @@
+#ifndef HX711AWAIT_H
+#define HX711AWAIT_H
+
+/*
+ * C++20 coroutines that await the readings of SimpleHX711, so one
+ * thread services many scales without polling.
+ *
+ * Copyright (C) 2016 Edwin Croissant
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * See the README.md file for additional information.
+ */
+
+#include <coroutine>
+#include <exception>
+#include <stdint.h>
+#include <vector>
+#include "SimpleHX711.h"
+
+/*
+ * the most scales an executor waits for
+ */
+#define HX711AWAIT_SCALES 64
+
+/*
+ * a coroutine that co_returns a bool. It starts when it is awaited or
+ * spawned on an executor and resumes its awaiter when it is done
+ */
+class HX711Task {
+public:
+	struct promise_type {
+		bool value = false;
+		std::coroutine_handle<> continuation;
+		HX711Task get_return_object() {
+			return HX711Task(
+					std::coroutine_handle<promise_type>::from_promise(*this));
+		}
+		std::suspend_always initial_suspend() noexcept {
+			return {};
+		}
+		struct finalAwaiter {
+			bool await_ready() noexcept {
+				return false;
+			}
+			std::coroutine_handle<> await_suspend(
+					std::coroutine_handle<promise_type> handle) noexcept {
+				if (handle.promise().continuation)
+					return handle.promise().continuation;
+				return std::noop_coroutine();
+			}
+			void await_resume() noexcept {
+			}
+		};
+		finalAwaiter final_suspend() noexcept {
+			return {};
+		}
+		void return_value(bool result) {
+			value = result;
+		}
+		void unhandled_exception() {
+			std::terminate();
+		}
+	};
+
+	HX711Task(HX711Task &&other) :
+			_handle(other._handle) {
+		other._handle = nullptr;
+	}
+	~HX711Task() {
+		if (_handle)
+			_handle.destroy();
+	}
+	bool await_ready() {
+		return false;
+	}
+	std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiter) {
+		_handle.promise().continuation = awaiter;
+		return _handle;
+	}
+	bool await_resume() {
+		return _handle.promise().value;
+	}
+	std::coroutine_handle<promise_type> release() {
+		std::coroutine_handle<promise_type> handle = _handle;
+		_handle = nullptr;
+		return handle;
+	}
+
+private:
+	HX711Task(std::coroutine_handle<promise_type> handle) :
+			_handle(handle) {
+	}
+	std::coroutine_handle<promise_type> _handle;
+};
+
+class HX711AwaitScale;
+
+/*
+ * runs the spawned tasks on one thread, it sleeps in epoll_wait until
+ * a scale the tasks wait for has a conversion ready
+ */
+class HX711Executor {
+public:
+	HX711Executor();
+	~HX711Executor();
+	bool begin();
+	void end();
+	void spawn(HX711Task task);
+	void run();
+	uint64_t getWakeups();
+
+private:
+	friend class HX711AwaitScale;
+	bool watch(HX711AwaitScale *scale);
+	int _epoll;
+	std::vector<std::coroutine_handle<HX711Task::promise_type> > _tasks;
+	std::vector<HX711AwaitScale*> _scales;
+	uint64_t _wakeups;
+};
+
+/*
+ * a scale the tasks can await. readyFd is a nonblocking file descriptor
+ * that becomes readable when DOUT falls: the timerfd of HX711SimChip,
+ * a GPIO line event request with falling edge detection or an eventfd
+ * written by an interrupt handler
+ */
+class HX711AwaitScale {
+public:
+	struct sampleAwaiter {
+		HX711AwaitScale &scale;
+		bool await_ready();
+		void await_suspend(std::coroutine_handle<> awaiter);
+		SimpleHX711::status await_resume();
+	};
+	HX711AwaitScale(HX711Executor &executor, SimpleHX711 &scale, int readyFd);
+	sampleAwaiter nextSample();
+	HX711Task stable(int32_t tolerance, uint8_t count, uint16_t limit = 100);
+	SimpleHX711 &getScale();
+	int getReadyFd();
+
+private:
+	friend class HX711Executor;
+	void ready(uint64_t now);
+	HX711Executor &_executor;
+	SimpleHX711 &_scale;
+	int _fd;
+	std::coroutine_handle<> _awaiter;
+	uint64_t _deadline;
+};
+
+#endif //  HX711AWAIT_H
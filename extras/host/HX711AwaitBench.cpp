@@ -0,0 +1,136 @@
+/*
+ * Compares awaiting the readings of many simulated scales on one
+ * HX711Executor with polling them in a loop, and awaits a settling load.
+ *
+ * Build and run from this directory with:
+ *   g++ -std=c++20 -O2 -I. -I../../src HX711AwaitBench.cpp HX711Await.cpp \
+ *       HX711SimChip.cpp ../../src/SimpleHX711.cpp -o HX711AwaitBench
+ *   ./HX711AwaitBench 32 80 3
+ * the arguments are the amount of scales, their data rate in Hz and the
+ * seconds each way runs.
+ */
+
+#include <memory>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+#include <time.h>
+#include <vector>
+#include "HX711Await.h"
+#include "HX711SimChip.h"
+
+static double seconds(int clock) {
+	struct timespec now;
+	clock_gettime(clock, &now);
+	return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+static HX711Task consume(HX711AwaitScale &scale, double until,
+		uint64_t &samples) {
+	SimpleHX711::status status;
+
+	while (seconds(CLOCK_MONOTONIC) < until) {
+		status = co_await scale.nextSample();
+		if (status != SimpleHX711::valid)
+			co_return false;
+		++samples;
+	}
+	co_return true;
+}
+
+static HX711Task settle(HX711AwaitScale &scale, HX711SimChip &chip) {
+	SimpleHX711::status status;
+	double start;
+	bool stable;
+
+	/*
+	 * wait until the scale is valid, then place a load that
+	 * settles with a time constant of 150 ms
+	 */
+	do {
+		status = co_await scale.nextSample();
+	} while (status != SimpleHX711::valid);
+	chip.setLoad(400000, 150);
+	start = seconds(CLOCK_MONOTONIC);
+	stable = co_await scale.stable(1000, 8);
+	printf("stable %s after %.0f ms at %ld\n", stable ? "true" : "false",
+			(seconds(CLOCK_MONOTONIC) - start) * 1000,
+			(long) scale.getScale().getAdjusted());
+	co_return stable;
+}
+
+static void report(const char *name, uint64_t samples, double wall,
+		double cpu, uint8_t count, uint32_t rate) {
+	printf("%s: %llu samples of %.0f, %.0f samples/s, %.1f %% cpu\n", name,
+			(unsigned long long) samples, wall * count * rate, samples / wall,
+			cpu / wall * 100);
+}
+
+int main(int argc, char *argv[]) {
+	uint8_t count = argc > 1 ? atoi(argv[1]) : 32;
+	uint32_t rate = argc > 2 ? strtoul(argv[2], NULL, 0) : 80;
+	double duration = argc > 3 ? atof(argv[3]) : 3;
+	std::vector<std::unique_ptr<HX711SimChip> > chips;
+	std::vector<std::unique_ptr<SimpleHX711> > scales;
+	uint8_t i;
+
+	if (!count || count > HX711AWAIT_SCALES)
+		return 1;
+	for (i = 0; i < count; ++i) {
+		chips.emplace_back(new HX711SimChip(2 * i, 2 * i + 1, rate));
+		chips.back()->setValue(1000 * i);
+		chips.back()->setNoise(64);
+		scales.emplace_back(new SimpleHX711(2 * i, 2 * i + 1));
+	}
+
+	/*
+	 * one executor thread awaits all scales
+	 */
+	{
+		HX711Executor executor;
+		std::vector<std::unique_ptr<HX711AwaitScale> > awaitables;
+		uint64_t samples = 0;
+		if (!executor.begin())
+			return 1;
+		for (i = 0; i < count; ++i)
+			awaitables.emplace_back(new HX711AwaitScale(executor, *scales[i],
+					chips[i]->getReadyFd()));
+		double wall = seconds(CLOCK_MONOTONIC);
+		double cpu = seconds(CLOCK_PROCESS_CPUTIME_ID);
+		for (i = 0; i < count; ++i)
+			executor.spawn(consume(*awaitables[i], wall + duration, samples));
+		executor.run();
+		report("await", samples, seconds(CLOCK_MONOTONIC) - wall,
+				seconds(CLOCK_PROCESS_CPUTIME_ID) - cpu, count, rate);
+		printf("await: %llu wakeups\n",
+				(unsigned long long) executor.getWakeups());
+	}
+
+	/*
+	 * the usual loop, read() on every scale over and over
+	 */
+	{
+		uint64_t samples = 0;
+		double wall = seconds(CLOCK_MONOTONIC);
+		double cpu = seconds(CLOCK_PROCESS_CPUTIME_ID);
+		while (seconds(CLOCK_MONOTONIC) < wall + duration)
+			for (i = 0; i < count; ++i)
+				if (scales[i]->read() && scales[i]->getStatus() == SimpleHX711::valid)
+					++samples;
+		report("poll", samples, seconds(CLOCK_MONOTONIC) - wall,
+				seconds(CLOCK_PROCESS_CPUTIME_ID) - cpu, count, rate);
+	}
+
+	/*
+	 * await a load settling on the first scale
+	 */
+	{
+		HX711Executor executor;
+		if (!executor.begin())
+			return 1;
+		HX711AwaitScale scale(executor, *scales[0], chips[0]->getReadyFd());
+		executor.spawn(settle(scale, *chips[0]));
+		executor.run();
+	}
+	return 0;
+}
@@ -0,0 +1,114 @@
+/*
+ * Measures how much of the platform vibration HX711Canceller removes and
+ * what it costs per reading. A platform moves with a 1.3 Hz sway and a
+ * 4.7 Hz shake, an accelerometer on it reports at 200 Hz with gravity
+ * and noise, the scale reads at 80 Hz and sees the acceleration 3 ms
+ * late through its own filter, plus its own noise. The load stays the
+ * same: during a load change a sketch freezes the filter with setAdapt.
+ *
+ * Build and run from this directory with:
+ *   g++ -O2 -I. -I../../src HX711CancellerBench.cpp \
+ *       ../../src/HX711Canceller.cpp -o HX711CancellerBench
+ *   ./HX711CancellerBench 600 4096
+ * the arguments are the simulated seconds and mu.
+ */
+
+#include <chrono>
+#include <math.h>
+#include <random>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+#include "HX711Canceller.h"
+
+/*
+ * the first seconds the filter learns, they don't count
+ */
+#define HX711CANCELLERBENCH_LEARN 30
+
+/*
+ * the acceleration of the platform at a time in seconds, in counts
+ * of the accelerometer
+ */
+static double acceleration(double time) {
+	return 1500 * sin(2 * M_PI * 1.3 * time)
+			+ 600 * sin(2 * M_PI * 4.7 * time + 1);
+}
+
+static double since(std::chrono::steady_clock::time_point start) {
+	return std::chrono::duration<double, std::nano>(
+			std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char *argv[]) {
+	uint32_t seconds = argc > 1 ? strtoul(argv[1], NULL, 0) : 600;
+	uint16_t mu = argc > 2 ? strtoul(argv[2], NULL, 0) : 4096;
+	std::mt19937 random(711);
+	std::normal_distribution<double> accelerometerNoise(0, 20);
+	std::normal_distribution<double> scaleNoise(0, 100);
+	std::vector<int16_t> references;
+	std::vector<uint32_t> referenceTimes;
+	std::vector<int32_t> readings, loads, cleaned;
+	std::vector<uint32_t> readingTimes;
+	HX711Canceller canceller(mu);
+	double before = 0, after = 0, time, elapsed;
+	uint32_t millis, count = 0;
+	size_t i, reference = 0;
+
+	/*
+	 * the references every 5 ms, the readings every 12.5 ms
+	 */
+	for (millis = 0; millis < seconds * 1000; millis += 5) {
+		time = millis / 1000.0;
+		references.push_back(lrint(16384 + acceleration(time)
+				+ accelerometerNoise(random)));
+		referenceTimes.push_back(millis);
+	}
+	for (i = 0; i * 12.5 < seconds * 1000.0; ++i) {
+		time = i * 0.0125;
+		loads.push_back(200000);
+		readings.push_back(lrint(loads.back()
+				+ 25 * acceleration(time - 0.003) + scaleNoise(random)));
+		readingTimes.push_back(lrint(i * 12.5));
+	}
+	cleaned.resize(readings.size());
+
+	/*
+	 * the references up to the reading go in first, like a sketch
+	 * that polls both
+	 */
+	auto start = std::chrono::steady_clock::now();
+	for (i = 0; i < readings.size(); ++i) {
+		for (; reference < references.size()
+				&& referenceTimes[reference] <= readingTimes[i]; ++reference)
+			canceller.addReference(references[reference],
+					referenceTimes[reference]);
+		cleaned[i] = canceller.cancel(readings[i], readingTimes[i]);
+	}
+	elapsed = since(start);
+
+	/*
+	 * the disturbance is what is left after removing the load
+	 */
+	for (i = 0; i < readings.size(); ++i) {
+		time = i * 0.0125;
+		if (time < HX711CANCELLERBENCH_LEARN)
+			continue;
+		before += double(readings[i] - loads[i]) * (readings[i] - loads[i]);
+		after += double(cleaned[i] - loads[i]) * (cleaned[i] - loads[i]);
+		++count;
+	}
+	if (!count) {
+		fprintf(stderr, "run longer than %d s\n", HX711CANCELLERBENCH_LEARN);
+		return 1;
+	}
+	before = sqrt(before / count);
+	after = sqrt(after / count);
+	printf("%zu readings, %zu references, mu %u\n", readings.size(),
+			references.size(), mu);
+	printf("rms %.0f before, %.0f after, %.1f dB cancelled\n", before, after,
+			20 * log10(before / after));
+	printf("%.1f ns per reading with its references\n",
+			elapsed / readings.size());
+	return 0;
+}
@@ -0,0 +1,95 @@
+/*
+ * Reads banks of 1 to 15 simulated HX711 chips behind a simulated I2C
+ * expander with HX711ExpanderBank at several bus speeds, checks the
+ * readings and reports the read time and the highest sample rate. A
+ * read fails when the host was busy during a clock pulse, the bank is
+ * then reset when the chips don't get ready again.
+ *
+ * Build and run from this directory with:
+ *   g++ -O2 -I. -I../../src HX711ExpanderBench.cpp HX711SimExpander.cpp \
+ *       HX711SimChip.cpp ../../src/HX711ExpanderBank.cpp \
+ *       ../../src/HX711Transpose.cpp -o HX711ExpanderBench
+ *   ./HX711ExpanderBench 80
+ * the argument is the data rate of the chips in Hz.
+ */
+
+#include <memory>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+#include "HX711SimChip.h"
+#include "HX711SimExpander.h"
+
+/*
+ * the expander pins start at this pin of the emulated board,
+ * expander pin 0 is the clock
+ */
+#define BASE 16
+
+static const uint32_t buses[] = { 100000, 400000, 1700000 };
+
+int main(int argc, char *argv[]) {
+	uint32_t rate = argc > 1 ? strtoul(argv[1], NULL, 0) : 80;
+	uint8_t bus, count, chip, reads;
+	uint32_t start;
+	int failures = 0;
+
+	for (bus = 0; bus < sizeof(buses) / sizeof(buses[0]); ++bus) {
+		printf("bus %lu kHz\n", (unsigned long) buses[bus] / 1000);
+		for (count = 1; count <= 15; ++count) {
+			std::vector<std::unique_ptr<HX711SimChip> > chips;
+			int32_t raw[15];
+			uint32_t slowest = 0, failed = 0, resets = 0;
+			uint16_t dataPins = 0;
+			bool correct = true;
+
+			for (chip = 0; chip < count; ++chip) {
+				chips.emplace_back(new HX711SimChip(BASE, BASE + chip + 1, rate));
+				chips.back()->setValue(-70000 + 10007 * chip);
+				dataPins |= uint16_t(1) << (chip + 1);
+			}
+			HX711SimExpander expander(BASE, buses[bus]);
+			HX711ExpanderBank bank(expander, 0, dataPins);
+			if (!bank.begin()) {
+				printf("  begin fails, a clock pulse takes %u us\n",
+						expander.pulse(0, 1));
+				break;
+			}
+			for (reads = 0; reads < 3;) {
+				start = millis();
+				while (!bank.isReady())
+					if (millis() - start > 1000) {
+						/*
+						 * the simulation allows a longer clock high than
+						 * the real chip before it powers down
+						 */
+						bank.powerDown();
+						delayMicroseconds(2000);
+						bank.powerUp();
+						++resets;
+						start = millis();
+					}
+				if (!bank.read(raw)) {
+					++failed;
+					continue;
+				}
+				++reads;
+				if (bank.getTiming().read > slowest)
+					slowest = bank.getTiming().read;
+				for (chip = 0; chip < count; ++chip)
+					if (raw[chip] >> 8 != -70000 + 10007 * chip)
+						correct = false;
+			}
+			if (!correct)
+				++failures;
+			printf("  %2u scales: read %5lu us, high %u us, at most %5.0f "
+					"samples/s", count, (unsigned long) slowest,
+					bank.getTiming().maxHigh, 1e6 / slowest);
+			if (failed)
+				printf(", %lu failed %lu resets", (unsigned long) failed,
+						(unsigned long) resets);
+			printf("%s\n", correct ? "" : " WRONG");
+		}
+	}
+	return failures ? 1 : 0;
+}
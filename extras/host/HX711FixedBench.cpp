@@ -0,0 +1,120 @@
+/*
+ * Checks HX711Weight against exact arithmetic and compares its speed with
+ * float: the quotient of a reading and the adjuster, a sum and formatting
+ * with 2 decimals. A quarter of the adjusters are near 2^24, like the
+ * 24 bit reading shifted left by 8. On a host float is done in hardware, on AVR in software.
+ *
+ * Build and run from this directory with:
+ *   g++ -O2 -I../../src HX711FixedBench.cpp -o HX711FixedBench
+ *   ./HX711FixedBench 1000000
+ * the argument is the amount of values per test.
+ */
+
+#include <chrono>
+#include <math.h>
+#include <random>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "HX711Fixed.h"
+
+static double since(std::chrono::steady_clock::time_point start) {
+	return std::chrono::duration<double, std::nano>(
+			std::chrono::steady_clock::now() - start).count();
+}
+
+/*
+ * the value rounded half away from zero to decimals, written exactly
+ */
+static void reference(long double value, uint8_t decimals, char *buffer) {
+	static const long powers[] = { 1, 10, 100, 1000, 10000 };
+	long double scaled = floorl(fabsl(value) * powers[decimals] + 0.5L);
+	long long whole = (long long) (scaled / powers[decimals]);
+	long fraction = (long) (scaled - (long double) whole * powers[decimals]);
+
+	if (!decimals)
+		sprintf(buffer, "%s%lld", value < 0 && scaled ? "-" : "", whole);
+	else
+		sprintf(buffer, "%s%lld.%0*ld", value < 0 && scaled ? "-" : "",
+				whole, decimals, fraction);
+}
+
+int main(int argc, char *argv[]) {
+	size_t count = argc > 1 ? strtoul(argv[1], NULL, 0) : 1000000, i;
+	std::mt19937 random(711);
+	std::uniform_int_distribution<int32_t> readings(-2147483647, 2147483647);
+	std::uniform_int_distribution<int32_t> adjusters(-200000, 200000);
+	std::uniform_int_distribution<int32_t> large(16000000, 16777215);
+	std::vector<int32_t> nets(count), dividers(count);
+	char text[HX711FIXED_TEXT], expected[64];
+	uint32_t wrong = 0, length = 0;
+	uint8_t decimals;
+
+	for (i = 0; i < count; ++i) {
+		nets[i] = readings(random) >> (random() % 24);
+		dividers[i] = adjusters(random);
+		if (!(i % 4))
+			dividers[i] = dividers[i] < 0 ? -large(random) : large(random);
+		if (!dividers[i])
+			dividers[i] = 1;
+	}
+
+	/*
+	 * the rounded quotient and its text against exact arithmetic
+	 */
+	for (i = 0; i < count; ++i) {
+		HX711Weight weight = HX711Weight::fromRatio(nets[i], dividers[i]);
+		long double exact = (long double) nets[i] / dividers[i];
+		long double error = fabsl(exact - (long double) weight.getRaw() / 256);
+		if (fabsl(exact) < 8388607 && error > 1.0L / 512 + 1e-9L)
+			++wrong;
+		decimals = i % (HX711FIXED_DECIMALS + 1);
+		weight.format(text, decimals);
+		reference((long double) weight.getRaw() / 256, decimals, expected);
+		if (strcmp(text, expected))
+			++wrong;
+	}
+	if (HX711Weight::fromInt(8388608).getRaw() != INT32_MAX
+			|| (HX711Weight::fromInt(-8388608) - HX711Weight::fromInt(1)).getRaw()
+					!= INT32_MIN
+			|| HX711Weight::fromRatio(16777214, 16777215).getRaw() != 256
+			|| HX711Weight::fromRatio(16759999, 16760000).getRaw() != 256
+			|| HX711Weight::fromRatio(-16777214, 16777215).getRaw() != -256
+			|| HX711Weight::fromFloat(2.5).toInt() != 3
+			|| HX711Weight::fromFloat(-2.5).toInt() != -3
+			|| (HX711Weight::fromFloat(1.5) * HX711Weight::fromFloat(-2.25)).toFloat()
+					!= -3.375f)
+		++wrong;
+	printf("%s\n", wrong ? "WRONG" : "all exact");
+
+	/*
+	 * the speed, the sums keep the results alive
+	 */
+	HX711Weight fixedSum;
+	float floatSum = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (i = 0; i < count; ++i)
+		fixedSum += HX711Weight::fromRatio(nets[i], dividers[i]);
+	double fixedRatio = since(start) / count;
+	start = std::chrono::steady_clock::now();
+	for (i = 0; i < count; ++i)
+		floatSum += float(nets[i]) / dividers[i];
+	double floatRatio = since(start) / count;
+
+	start = std::chrono::steady_clock::now();
+	for (i = 0; i < count; ++i)
+		length += HX711Weight::fromRaw(nets[i]).format(text, 2);
+	double fixedFormat = since(start) / count;
+	start = std::chrono::steady_clock::now();
+	for (i = 0; i < count; ++i)
+		length += snprintf(text, sizeof(text), "%.2f", nets[i] / 256.0f);
+	double floatFormat = since(start) / count;
+
+	printf("ns per value    fixed    float\n");
+	printf("quotient     %8.1f %8.1f\n", fixedRatio, floatRatio);
+	printf("format       %8.1f %8.1f\n", fixedFormat, floatFormat);
+	if (!length && fixedSum.getRaw() == 1 && floatSum == 1)
+		printf(" \n");
+	return wrong ? 1 : 0;
+}
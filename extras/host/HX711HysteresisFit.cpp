@@ -0,0 +1,221 @@
+/*
+ * Finds the amplitude and width of HX711Hysteresis from recorded load
+ * cycles. The recording is a csv file of reference loads and readings,
+ * both in raw units, one pair per line, for instance from stepping known
+ * weights up and down. For every width on a grid the readings are fitted
+ * as gain * reference + offset + amplitude * error of a model with
+ * amplitude 1 by least squares, the best width is refined by a golden
+ * section search.
+ *
+ * Build from this directory with:
+ *   g++ -O2 -I. -I../../src HX711HysteresisFit.cpp \
+ *       ../../src/HX711Hysteresis.cpp -o HX711HysteresisFit
+ * Usage:
+ *   HX711HysteresisFit cycles.csv [threshold]
+ *   HX711HysteresisFit                  fits simulated cycles
+ */
+
+#include <math.h>
+#include <random>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+#include "HX711Hysteresis.h"
+
+struct fit {
+	double width;
+	double gain;
+	double offset;
+	double amplitude;
+	double rms;
+};
+
+/*
+ * solves the 3 by 3 system a x = b with Cramer's rule,
+ * returns false when it is singular
+ */
+static bool solve(double a[3][3], const double b[3], double x[3]) {
+	double determinant, column[3][3];
+	uint8_t i, j, k;
+
+	determinant = a[0][0] * (a[1][1] * a[2][2] - a[1][2] * a[2][1])
+			- a[0][1] * (a[1][0] * a[2][2] - a[1][2] * a[2][0])
+			+ a[0][2] * (a[1][0] * a[2][1] - a[1][1] * a[2][0]);
+	if (fabs(determinant) < 1e-30)
+		return false;
+	for (k = 0; k < 3; ++k) {
+		for (i = 0; i < 3; ++i)
+			for (j = 0; j < 3; ++j)
+				column[i][j] = j == k ? b[i] : a[i][j];
+		x[k] = (column[0][0]
+				* (column[1][1] * column[2][2] - column[1][2] * column[2][1])
+				- column[0][1]
+						* (column[1][0] * column[2][2] - column[1][2] * column[2][0])
+				+ column[0][2]
+						* (column[1][0] * column[2][1] - column[1][1] * column[2][0]))
+				/ determinant;
+	}
+	return true;
+}
+
+/*
+ * fits gain, offset and amplitude for a width, the model runs on the
+ * readings like it does on the scale
+ */
+static fit fitWidth(const std::vector<double> &references,
+		const std::vector<int32_t> &readings, double width, int32_t threshold) {
+	HX711Hysteresis model(1, width, threshold);
+	double a[3][3] = { { 0 } }, b[3] = { 0 }, x[3], row[3], residual;
+	fit result = { width, 0, 0, 0, INFINITY };
+	size_t i;
+	uint8_t j, k;
+	std::vector<double> errors(readings.size());
+
+	for (i = 0; i < readings.size(); ++i) {
+		model.correct(readings[i]);
+		errors[i] = model.getError();
+		row[0] = references[i];
+		row[1] = 1;
+		row[2] = errors[i];
+		for (j = 0; j < 3; ++j) {
+			for (k = 0; k < 3; ++k)
+				a[j][k] += row[j] * row[k];
+			b[j] += row[j] * readings[i];
+		}
+	}
+	if (!solve(a, b, x))
+		return result;
+	result.gain = x[0];
+	result.offset = x[1];
+	result.amplitude = x[2];
+	result.rms = 0;
+	for (i = 0; i < readings.size(); ++i) {
+		residual = readings[i] - x[0] * references[i] - x[1] - x[2] * errors[i];
+		result.rms += residual * residual;
+	}
+	result.rms = sqrt(result.rms / readings.size());
+	return result;
+}
+
+/*
+ * the rms of a straight line fit, without hysteresis
+ */
+static double fitLine(const std::vector<double> &references,
+		const std::vector<int32_t> &readings) {
+	double sx = 0, sy = 0, sxx = 0, sxy = 0, n = readings.size();
+	double gain, offset, residual, sum = 0;
+	size_t i;
+
+	for (i = 0; i < readings.size(); ++i) {
+		sx += references[i];
+		sy += readings[i];
+		sxx += references[i] * references[i];
+		sxy += references[i] * readings[i];
+	}
+	gain = (n * sxy - sx * sy) / (n * sxx - sx * sx);
+	offset = (sy - gain * sx) / n;
+	for (i = 0; i < readings.size(); ++i) {
+		residual = readings[i] - gain * references[i] - offset;
+		sum += residual * residual;
+	}
+	return sqrt(sum / n);
+}
+
+/*
+ * load cycles between 0 and 4000000 raw with minor loops, read through
+ * a model with amplitude 3000 and width 600000 and noise
+ */
+static void simulate(std::vector<double> &references,
+		std::vector<int32_t> &readings) {
+	static const double turns[] = { 4000000, 0, 4000000, 1500000, 3000000, 0,
+			2000000, 500000, 4000000, 2500000, 3500000, 0 };
+	std::mt19937 random(711);
+	std::normal_distribution<double> noise(0, 150);
+	HX711Hysteresis truth(3000, 600000);
+	double load = 0, target, step;
+	uint8_t turn;
+
+	for (turn = 0; turn < sizeof(turns) / sizeof(turns[0]); ++turn) {
+		target = turns[turn];
+		step = target > load ? 20000 : -20000;
+		for (; fabs(target - load) > 1; load += step) {
+			/*
+			 * the true model adds the error, the fit has to find it back
+			 */
+			truth.correct(load);
+			references.push_back(load);
+			readings.push_back(lrint(1.02 * load + 8000 + truth.getError()
+					+ noise(random)));
+		}
+	}
+}
+
+int main(int argc, char *argv[]) {
+	std::vector<double> references;
+	std::vector<int32_t> readings;
+	int32_t threshold = argc > 2 ? atol(argv[2]) : 500;
+	double low = INFINITY, high = -INFINITY, span, a, b, c, d;
+	fit best = { 0, 0, 0, 0, INFINITY }, candidate;
+	size_t i;
+
+	if (argc > 1) {
+		FILE *file = fopen(argv[1], "r");
+		double reference;
+		long reading;
+		char line[256];
+		if (!file) {
+			fprintf(stderr, "%s: can't open\n", argv[1]);
+			return 1;
+		}
+		while (fgets(line, sizeof(line), file))
+			if (sscanf(line, "%lf,%ld", &reference, &reading) == 2) {
+				references.push_back(reference);
+				readings.push_back(reading);
+			}
+		fclose(file);
+	} else
+		simulate(references, readings);
+	if (readings.size() < 10) {
+		fprintf(stderr, "too few readings\n");
+		return 1;
+	}
+	for (i = 0; i < readings.size(); ++i) {
+		low = fmin(low, readings[i]);
+		high = fmax(high, readings[i]);
+	}
+	span = high - low > 1 ? high - low : 1;
+
+	/*
+	 * widths from 1/1000 to 2 times the span on a log grid
+	 */
+	for (i = 0; i <= 80; ++i) {
+		candidate = fitWidth(references, readings,
+				span * pow(10, -3 + 3.3 * i / 80), threshold);
+		if (candidate.rms < best.rms)
+			best = candidate;
+	}
+	a = log(best.width) - 0.1;
+	b = log(best.width) + 0.1;
+	for (i = 0; i < 40; ++i) {
+		c = b - (b - a) * 0.618;
+		d = a + (b - a) * 0.618;
+		if (fitWidth(references, readings, exp(c), threshold).rms
+				< fitWidth(references, readings, exp(d), threshold).rms)
+			b = d;
+		else
+			a = c;
+	}
+	candidate = fitWidth(references, readings, exp((a + b) / 2), threshold);
+	if (candidate.rms < best.rms)
+		best = candidate;
+
+	printf("%zu readings, span %.0f\n", readings.size(), span);
+	printf("gain %.5f offset %.1f\n", best.gain, best.offset);
+	printf("amplitude %.1f width %.0f threshold %ld\n", best.amplitude,
+			best.width, (long) threshold);
+	printf("rms %.1f without hysteresis, %.1f with\n",
+			fitLine(references, readings), best.rms);
+	printf("HX711Hysteresis hysteresis(%.1f, %.0f, %ld);\n", best.amplitude,
+			best.width, (long) threshold);
+	return 0;
+}
@@ -0,0 +1,48 @@
+/*
+ * Host test of the sustained rate of HX711Logger with a file backend.
+ *
+ * Build and run from this directory with:
+ *   g++ -O2 -I../../src HX711LoggerRate.cpp ../../src/HX711Logger.cpp -o HX711LoggerRate
+ *   ./HX711LoggerRate log.bin 1000000 64
+ * the arguments are the file, the amount of samples and the slice size.
+ * One service() call is made per sample, like a sketch calling add()
+ * from read() and service() from the loop.
+ */
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include "HX711Logger.h"
+
+int main(int argc, char *argv[]) {
+	if (argc < 2) {
+		fprintf(stderr, "usage: %s file [samples] [slice]\n", argv[0]);
+		return 1;
+	}
+	FILE *file = fopen(argv[1], "wb");
+	if (!file) {
+		perror(argv[1]);
+		return 1;
+	}
+	uint32_t samples = argc > 2 ? strtoul(argv[2], NULL, 0) : 1000000;
+	uint16_t slice = argc > 3 ? strtoul(argv[3], NULL, 0) : HX711LOGGER_SLICE;
+
+	HX711FileBackend backend(file);
+	HX711Logger logger(backend, slice);
+	auto start = std::chrono::steady_clock::now();
+	for (uint32_t i = 0; i < samples; ++i) {
+		logger.add(int32_t(i * 2654435761u) >> 8, i * 12);
+		logger.service();
+	}
+	logger.flush();
+	fclose(file);
+	double seconds = std::chrono::duration<double>(
+			std::chrono::steady_clock::now() - start).count();
+
+	printf("%u samples in %lu blocks, %lu dropped, %.3f s\n", samples,
+			(unsigned long) logger.getBlocks(),
+			(unsigned long) logger.getDropped(), seconds);
+	printf("%.0f samples/s, %.1f MB/s\n", samples / seconds,
+			logger.getBlocks() * sizeof(HX711LogBlock) / seconds / 1e6);
+	return 0;
+}
@@ -0,0 +1,115 @@
+/*
+ * Runs HX711PinChange with simulated scales that convert independently,
+ * the port is read in a loop in place of the pin change interrupt.
+ * Reports the cost of an interrupt and of a service without a new
+ * conversion against polling every scale, and checks that every
+ * conversion is read.
+ *
+ * Build and run from this directory with:
+ *   g++ -O2 -I. -I../../src HX711PinChangeBench.cpp HX711SimChip.cpp \
+ *       ../../src/HX711PinChange.cpp ../../src/SimpleHX711.cpp \
+ *       -o HX711PinChangeBench
+ *   ./HX711PinChangeBench 2
+ * the argument is the seconds per amount of scales.
+ */
+
+#include <memory>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <vector>
+#include "HX711PinChange.h"
+#include "HX711SimChip.h"
+
+/*
+ * the data line of scale n is pin DATA + n of the emulated board,
+ * its clock is pin CLOCK + n
+ */
+#define CLOCK 0
+#define DATA 8
+
+static const uint8_t counts[] = { 1, 2, 4, 8 };
+
+static uint64_t nanos() {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return uint64_t(now.tv_sec) * 1000000000 + now.tv_nsec;
+}
+
+/*
+ * the levels of the port, one read of PINB on AVR
+ */
+static uint8_t port(uint8_t count) {
+	uint8_t levels = 0xFF, bit;
+
+	for (bit = 0; bit < count; ++bit)
+		if (!digitalRead(DATA + bit))
+			levels &= ~(1 << bit);
+	return levels;
+}
+
+int main(int argc, char *argv[]) {
+	double duration = argc > 1 ? atof(argv[1]) : 2;
+	uint8_t size, count, i;
+	int failures = 0;
+
+	printf("scales interrupt  service     poll ns, conversions read\n");
+	for (size = 0; size < sizeof(counts) / sizeof(counts[0]); ++size) {
+		std::vector<std::unique_ptr<HX711SimChip> > chips;
+		std::vector<std::unique_ptr<SimpleHX711> > scales;
+		HX711PinChange dispatcher;
+		uint64_t start, until, spent[3] = { 0, 0, 0 }, calls[3] = { 0, 0, 0 };
+		uint32_t conversions = 0, reads = 0;
+		uint8_t levels;
+
+		count = counts[size];
+		for (i = 0; i < count; ++i) {
+			/*
+			 * 10 to 80 Hz so they drift apart
+			 */
+			chips.emplace_back(new HX711SimChip(CLOCK + i, DATA + i, 10 + 10 * i));
+			scales.emplace_back(new SimpleHX711(CLOCK + i, DATA + i));
+			dispatcher.add(*scales.back(), i);
+		}
+		dispatcher.check(port(count));
+		until = nanos() + uint64_t(duration * 1e9);
+		while (nanos() < until) {
+			levels = port(count);
+			start = nanos();
+			dispatcher.interrupt(levels);
+			spent[0] += nanos() - start;
+			++calls[0];
+			start = nanos();
+			if (dispatcher.service())
+				continue;
+			spent[1] += nanos() - start;
+			++calls[1];
+		}
+		/*
+		 * what the usual loop pays every time, a read of every scale
+		 */
+		until = nanos() + 100000000;
+		while (nanos() < until) {
+			start = nanos();
+			for (i = 0; i < count; ++i)
+				scales[i]->read();
+			spent[2] += nanos() - start;
+			++calls[2];
+		}
+		for (i = 0; i < count; ++i) {
+			conversions += chips[i]->getConversions();
+			reads += chips[i]->getReads();
+		}
+		/*
+		 * the polling loop read some too, and the last
+		 * conversion may still be pending
+		 */
+		if (reads + count < conversions)
+			++failures;
+		printf("%6u %9.0f %8.0f %8.0f    %lu of %lu\n", count,
+				double(spent[0]) / calls[0], double(spent[1]) / calls[1],
+				double(spent[2]) / calls[2], (unsigned long) reads,
+				(unsigned long) conversions);
+	}
+	return failures ? 1 : 0;
+}
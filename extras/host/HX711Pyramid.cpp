@@ -0,0 +1,239 @@
+#include <stdio.h>
+#include <string.h>
+#include "HX711Pyramid.h"
+
+/*
+ * an empty summary
+ */
+void HX711Summary::begin() {
+	firstTimestamp = 0;
+	lastTimestamp = 0;
+	sum = 0;
+	count = 0;
+	min = INT32_MAX;
+	max = INT32_MIN;
+}
+
+/*
+ * adds one sample, samples are added in time order
+ */
+void HX711Summary::add(uint64_t timestamp, int32_t raw) {
+	if (!count)
+		firstTimestamp = timestamp;
+	lastTimestamp = timestamp;
+	sum += raw;
+	++count;
+	if (raw < min)
+		min = raw;
+	if (raw > max)
+		max = raw;
+}
+
+/*
+ * adds a summary of later samples
+ */
+void HX711Summary::add(const HX711Summary &summary) {
+	if (!summary.count)
+		return;
+	if (!count)
+		firstTimestamp = summary.firstTimestamp;
+	lastTimestamp = summary.lastTimestamp;
+	sum += summary.sum;
+	count += summary.count;
+	if (summary.min < min)
+		min = summary.min;
+	if (summary.max > max)
+		max = summary.max;
+}
+
+/*
+ * returns the mean, 0 for an empty summary
+ */
+double HX711Summary::getMean() const {
+	return count ? double(sum) / count : 0;
+}
+
+HX711Pyramid::HX711Pyramid() {
+	clear();
+}
+
+/*
+ * removes all samples
+ */
+void HX711Pyramid::clear() {
+	_levels.clear();
+	_samples = 0;
+}
+
+/*
+ * appends a sample, the timestamps must increase
+ */
+void HX711Pyramid::add(uint64_t timestamp, int32_t raw) {
+	HX711Summary node;
+	uint64_t capacity = HX711PYRAMID_LEAF;
+	size_t level, i;
+
+	++_samples;
+	if (_levels.empty())
+		_levels.resize(1);
+	for (level = 0;; ++level, capacity *= HX711PYRAMID_FACTOR) {
+		if (level == _levels.size()) {
+			/*
+			 * a new top level starts with everything below it,
+			 * including this sample
+			 */
+			_levels.resize(level + 1);
+			node.begin();
+			for (i = 0; i < _levels[level - 1].size(); ++i)
+				node.add(_levels[level - 1][i]);
+			_levels[level].push_back(node);
+			return;
+		}
+		std::vector<HX711Summary> &nodes = _levels[level];
+		if (nodes.empty() || nodes.back().count >= capacity) {
+			node.begin();
+			nodes.push_back(node);
+		}
+		nodes.back().add(timestamp, raw);
+		/*
+		 * a level with one node is the top
+		 */
+		if (nodes.size() == 1)
+			return;
+	}
+}
+
+/*
+ * adds the part of a node that lies in the window to the summary
+ */
+void HX711Pyramid::visit(uint8_t level, size_t node, uint64_t from,
+		uint64_t to, HX711SeriesReader *reader, HX711Summary &summary) {
+	const HX711Summary &current = _levels[level][node];
+	size_t child, last;
+
+	if (!current.count || current.lastTimestamp < from
+			|| current.firstTimestamp > to)
+		return;
+	if (current.firstTimestamp >= from && current.lastTimestamp <= to) {
+		summary.add(current);
+		return;
+	}
+	if (level) {
+		last = (node + 1) * HX711PYRAMID_FACTOR;
+		if (last > _levels[level - 1].size())
+			last = _levels[level - 1].size();
+		for (child = node * HX711PYRAMID_FACTOR; child < last; ++child)
+			visit(level - 1, child, from, to, reader, summary);
+		return;
+	}
+	/*
+	 * a leaf on the edge of the window, without the samples
+	 * the whole leaf is counted
+	 */
+	if (!reader) {
+		summary.add(current);
+		return;
+	}
+	_refine.clear();
+	reader->read(from > current.firstTimestamp ? from : current.firstTimestamp,
+			to < current.lastTimestamp ? to : current.lastTimestamp, _refine);
+	for (child = 0; child < _refine.size(); ++child)
+		summary.add(_refine[child].timestamp, _refine[child].raw);
+}
+
+/*
+ * returns the summary of the samples with a timestamp from up to and
+ * including to. With the reader of the recording the leaves on the edges
+ * of the window are summarised exactly, otherwise they count as a whole
+ */
+HX711Summary HX711Pyramid::summarise(uint64_t from, uint64_t to,
+		HX711SeriesReader *reader) {
+	HX711Summary summary;
+	size_t node;
+
+	summary.begin();
+	if (_levels.empty())
+		return summary;
+	for (node = 0; node < _levels.back().size(); ++node)
+		visit(_levels.size() - 1, node, from, to, reader, summary);
+	return summary;
+}
+
+/*
+ * returns the amount of samples added
+ */
+uint64_t HX711Pyramid::getSamples() {
+	return _samples;
+}
+
+/*
+ * returns the amount of levels
+ */
+uint8_t HX711Pyramid::getLevels() {
+	return _levels.size();
+}
+
+/*
+ * returns the amount of nodes in a level
+ */
+size_t HX711Pyramid::getNodes(uint8_t level) {
+	return level < _levels.size() ? _levels[level].size() : 0;
+}
+
+/*
+ * writes the pyramid to a file: the magic, the amount of samples and
+ * levels, and per level the amount of nodes followed by the nodes
+ */
+bool HX711Pyramid::save(const char *name) {
+	uint64_t header[2] = { _samples, _levels.size() }, nodes;
+	bool success;
+	size_t level;
+	FILE *file = fopen(name, "wb");
+
+	if (!file)
+		return false;
+	success = fwrite(HX711PYRAMID_MAGIC, 8, 1, file) == 1
+			&& fwrite(header, sizeof(header), 1, file) == 1;
+	for (level = 0; success && level < _levels.size(); ++level) {
+		nodes = _levels[level].size();
+		success = fwrite(&nodes, sizeof(nodes), 1, file) == 1
+				&& fwrite(_levels[level].data(), sizeof(HX711Summary), nodes,
+						file) == nodes;
+	}
+	return fclose(file) == 0 && success;
+}
+
+/*
+ * reads a pyramid written by save, appending continues where it ended
+ */
+bool HX711Pyramid::load(const char *name) {
+	uint64_t header[2], nodes;
+	char magic[8];
+	bool success;
+	size_t level;
+	FILE *file = fopen(name, "rb");
+
+	clear();
+	if (!file)
+		return false;
+	success = fread(magic, 8, 1, file) == 1
+			&& !memcmp(magic, HX711PYRAMID_MAGIC, 8)
+			&& fread(header, sizeof(header), 1, file) == 1 && header[1] < 64;
+	if (success) {
+		_samples = header[0];
+		_levels.resize(header[1]);
+	}
+	for (level = 0; success && level < _levels.size(); ++level) {
+		success = fread(&nodes, sizeof(nodes), 1, file) == 1
+				&& nodes <= _samples + 1;
+		if (success) {
+			_levels[level].resize(nodes);
+			success = fread(_levels[level].data(), sizeof(HX711Summary), nodes,
+					file) == nodes;
+		}
+	}
+	fclose(file);
+	if (!success)
+		clear();
+	return success;
+}
@@ -0,0 +1,76 @@
+#ifndef HX711PYRAMID_H
+#define HX711PYRAMID_H
+
+/*
+ * Min, max and mean pyramid over long SimpleHX711 recordings, for the host.
+ *
+ * Copyright (C) 2016 Edwin Croissant
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * See the README.md file for additional information.
+ */
+
+#include <stdint.h>
+#include <vector>
+#include "HX711Series.h"
+
+/*
+ * Every node of level 0 summarises HX711PYRAMID_LEAF samples and every
+ * node of a higher level summarises HX711PYRAMID_FACTOR nodes of the level
+ * below. A node takes 40 bytes, a leaf of 256 samples keeps the pyramid
+ * under a tenth of the size of the recording (about 2 bytes a sample). Samples are appended one at a time and only the last node of
+ * every level changes, so the pyramid grows with the recording. A time
+ * window is summarised by descending from the top level into the nodes
+ * that lie partly in the window only, which reads O(log n) nodes.
+ */
+#define HX711PYRAMID_LEAF 256
+#define HX711PYRAMID_FACTOR 16
+#define HX711PYRAMID_MAGIC "HX711PY2"
+
+struct HX711Summary {
+	uint64_t firstTimestamp;
+	uint64_t lastTimestamp;
+	int64_t sum;
+	uint64_t count;
+	int32_t min;
+	int32_t max;
+	void begin();
+	void add(uint64_t timestamp, int32_t raw);
+	void add(const HX711Summary &summary);
+	double getMean() const;
+};
+
+class HX711Pyramid {
+public:
+	HX711Pyramid();
+	void clear();
+	void add(uint64_t timestamp, int32_t raw);
+	HX711Summary summarise(uint64_t from, uint64_t to,
+			HX711SeriesReader *reader = NULL);
+	uint64_t getSamples();
+	uint8_t getLevels();
+	size_t getNodes(uint8_t level);
+	bool save(const char *name);
+	bool load(const char *name);
+
+private:
+	void visit(uint8_t level, size_t node, uint64_t from, uint64_t to,
+			HX711SeriesReader *reader, HX711Summary &summary);
+	std::vector<std::vector<HX711Summary> > _levels;
+	uint64_t _samples;
+	std::vector<HX711SeriesSample> _refine;
+};
+
+#endif //  HX711PYRAMID_H
@@ -0,0 +1,75 @@
+/*
+ * Compares HX711Quantile with the exact quantiles of a recording, the
+ * median and the 95th and 99th percentile, and times the updates.
+ *
+ * Build and run from this directory with:
+ *   g++ -O2 -I. -I../../src HX711QuantileBench.cpp HX711Series.cpp \
+ *       ../../src/HX711Quantile.cpp -o HX711QuantileBench
+ *   ./HX711QuantileBench [in.hts]
+ * without a file it makes a recording of 1000000 item weights: normal
+ * with a standard deviation of 200 around 500000 and one in 50 items
+ * with a skewed overfill.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <stdio.h>
+#include <vector>
+#include "HX711Quantile.h"
+#include "HX711Series.h"
+
+static const float probabilities[] = { 0.5, 0.95, 0.99 };
+
+int main(int argc, char *argv[]) {
+	std::vector<int32_t> values, sorted;
+	uint8_t i;
+	size_t j;
+
+	if (argc > 1) {
+		HX711SeriesReader reader;
+		std::vector<HX711SeriesSample> samples;
+		if (!reader.open(argv[1])) {
+			fprintf(stderr, "%s: not a series file\n", argv[1]);
+			return 1;
+		}
+		reader.read(0, UINT64_MAX, samples);
+		for (j = 0; j < samples.size(); ++j)
+			values.push_back(samples[j].raw);
+	} else {
+		std::mt19937 random(711);
+		std::normal_distribution<float> weight(500000, 200);
+		std::exponential_distribution<float> overfill(1.0f / 2000);
+		std::uniform_int_distribution<int> item(0, 49);
+		for (j = 0; j < 1000000; ++j)
+			values.push_back(weight(random)
+					+ (item(random) ? 0 : overfill(random)));
+	}
+	if (values.empty())
+		return 1;
+	sorted = values;
+	std::sort(sorted.begin(), sorted.end());
+
+	printf("%zu values\n", values.size());
+	printf("quantile        exact     estimate    error  rank of estimate  ns\n");
+	for (i = 0; i < sizeof(probabilities) / sizeof(probabilities[0]); ++i) {
+		HX711Quantile quantile(probabilities[i]);
+		auto start = std::chrono::steady_clock::now();
+		for (j = 0; j < values.size(); ++j)
+			quantile.add(values[j]);
+		double ns = std::chrono::duration<double, std::nano>(
+				std::chrono::steady_clock::now() - start).count()
+				/ values.size();
+		int32_t exact = sorted[size_t(probabilities[i] * (sorted.size() - 1))];
+		float estimate = quantile.getQuantile();
+		/*
+		 * the fraction of values below the estimate, the
+		 * probability for a perfect estimate
+		 */
+		double rank = double(std::lower_bound(sorted.begin(), sorted.end(),
+				estimate) - sorted.begin()) / sorted.size();
+		printf("%8.2f %12ld %12.1f %8.1f  %16.4f %3.0f\n", probabilities[i],
+				(long) exact, estimate, estimate - exact, rank, ns);
+	}
+	return 0;
+}
@@ -0,0 +1,99 @@
+/*
+ * Host benchmark of the HX711Rice block compression.
+ *
+ * Build and run from this directory with:
+ *   g++ -O2 -I../../src HX711RiceBench.cpp ../../src/HX711Rice.cpp -o HX711RiceBench
+ *   ./HX711RiceBench [log.bin]
+ * Without a file a simulated 80 SPS recording is used, with a file the
+ * samples are read from a log written by HX711Logger. Every block is
+ * decoded again and compared with the input.
+ */
+
+#include <chrono>
+#include <random>
+#include <vector>
+#include <stdio.h>
+#include "HX711Logger.h"
+#include "HX711Rice.h"
+
+static std::vector<HX711Sample> simulate(size_t count) {
+	std::vector<HX711Sample> samples(count);
+	std::mt19937 generator(711);
+	std::normal_distribution<double> noise(0, 20);
+	double load = 0;
+	for (size_t i = 0; i < count; ++i) {
+		/*
+		 * a new load every minute, the readings have 8 zero bits
+		 * on the right like SimpleHX711
+		 */
+		if (i % 4800 == 0)
+			load = (generator() % 400000);
+		samples[i].timestamp = i * 25 / 2;
+		samples[i].raw = int32_t(100000 + load + noise(generator)) * 256;
+	}
+	return samples;
+}
+
+static std::vector<HX711Sample> load(const char *name) {
+	std::vector<HX711Sample> samples;
+	HX711LogBlock block;
+	FILE *file = fopen(name, "rb");
+	if (!file) {
+		perror(name);
+		return samples;
+	}
+	while (fread(&block, sizeof(block), 1, file) == 1)
+		samples.insert(samples.end(), block.samples,
+				block.samples + block.count);
+	fclose(file);
+	return samples;
+}
+
+int main(int argc, char *argv[]) {
+	std::vector<HX711Sample> samples =
+			argc > 1 ? load(argv[1]) : simulate(1000000);
+	if (samples.empty())
+		return 1;
+
+	std::vector<std::vector<uint8_t> > blocks;
+	uint8_t buffer[512];
+	size_t bytes = 0, i = 0;
+	auto start = std::chrono::steady_clock::now();
+	while (i < samples.size()) {
+		HX711RiceEncoder encoder(buffer, sizeof(buffer));
+		while (i < samples.size()
+				&& encoder.add(samples[i].raw, samples[i].timestamp))
+			++i;
+		uint16_t length = encoder.finish();
+		blocks.push_back(std::vector<uint8_t>(buffer, buffer + length));
+		bytes += length;
+	}
+	double encodeTime = std::chrono::duration<double>(
+			std::chrono::steady_clock::now() - start).count();
+
+	size_t j = 0, errors = 0;
+	HX711Sample sample;
+	start = std::chrono::steady_clock::now();
+	for (size_t b = 0; b < blocks.size(); ++b) {
+		HX711RiceDecoder decoder(blocks[b].data(), blocks[b].size());
+		while (decoder.next(sample)) {
+			if (sample.raw != samples[j].raw
+					|| sample.timestamp != samples[j].timestamp)
+				++errors;
+			++j;
+		}
+	}
+	double decodeTime = std::chrono::duration<double>(
+			std::chrono::steady_clock::now() - start).count();
+
+	printf("%zu samples in %zu blocks, %zu errors%s\n", samples.size(),
+			blocks.size(), errors + samples.size() - j,
+			argc > 1 ? "" : " (simulated)");
+	printf("%.2f bits per sample, %.2f x smaller than HX711LogBlock\n",
+			bytes * 8.0 / samples.size(),
+			samples.size() * double(sizeof(HX711LogBlock))
+					/ HX711LOGGER_SAMPLES / bytes);
+	printf("encode %.1f M samples/s, decode %.1f M samples/s\n",
+			samples.size() / encodeTime / 1e6, j / decodeTime / 1e6);
+	return errors || j != samples.size();
+}
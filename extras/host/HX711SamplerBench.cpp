@@ -0,0 +1,93 @@
+/*
+ * Test and benchmark of HX711Sampler in a HX711SamplerThread with
+ * simulated scales and a consumer thread, for every queue policy.
+ *
+ * Build and run from this directory with:
+ *   g++ -std=c++20 -O2 -pthread -I. -I../../src HX711SamplerBench.cpp \
+ *       HX711SamplerThread.cpp HX711SimChip.cpp ../../src/HX711Sampler.cpp \
+ *       ../../src/SimpleHX711.cpp -o HX711SamplerBench
+ *   ./HX711SamplerBench 8 80 2 2000
+ * the arguments are the amount of scales, their data rate in Hz, the
+ * seconds per policy and the microseconds the consumer takes per record.
+ * A consumer slower than the scales shows what every policy drops.
+ */
+
+#include <memory>
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+#include <vector>
+#include "HX711SamplerThread.h"
+#include "HX711SimChip.h"
+
+static const char *names[] = { "dropOldest", "dropNewest", "block" };
+
+int main(int argc, char *argv[]) {
+	uint8_t count = argc > 1 ? atoi(argv[1]) : 8;
+	uint32_t rate = argc > 2 ? strtoul(argv[2], NULL, 0) : 80;
+	double duration = argc > 3 ? atof(argv[3]) : 2;
+	uint32_t work = argc > 4 ? strtoul(argv[4], NULL, 0) : 2000;
+	int failed = 0;
+
+	if (!count || count > HX711SAMPLER_SCALES)
+		return 1;
+	for (int policy = HX711Sampler::dropOldest; policy <= HX711Sampler::block;
+			++policy) {
+		std::vector<std::unique_ptr<HX711SimChip> > chips;
+		std::vector<std::unique_ptr<SimpleHX711> > scales;
+		HX711Sampler sampler(static_cast<HX711Sampler::policy>(policy));
+		HX711SamplerThread thread(sampler);
+		uint8_t i;
+
+		for (i = 0; i < count; ++i) {
+			chips.emplace_back(new HX711SimChip(2 * i, 2 * i + 1, rate));
+			chips.back()->setValue(1000 * (i + 1));
+			scales.emplace_back(new SimpleHX711(2 * i, 2 * i + 1, 1));
+			thread.add(*scales.back(), chips.back()->getReadyFd());
+		}
+
+		/*
+		 * the consumer checks every scale arrives in order and
+		 * measures the age of the records
+		 */
+		uint64_t consumed = 0, age = 0, unordered = 0, wrong = 0;
+		thread.start();
+		std::thread consumer([&]() {
+			std::vector<uint32_t> last(count, 0);
+			HX711SamplerRecord record;
+			while (thread.pop(record)) {
+				if (record.sample.timestamp < last[record.scale])
+					++unordered;
+				if (record.sample.raw / 256 != 1000 * (record.scale + 1))
+					++wrong;
+				last[record.scale] = record.sample.timestamp;
+				age += millis() - record.sample.timestamp;
+				++consumed;
+				if (work)
+					std::this_thread::sleep_for(std::chrono::microseconds(work));
+			}
+		});
+		std::this_thread::sleep_for(std::chrono::duration<double>(duration));
+		thread.stop();
+		consumer.join();
+
+		uint32_t conversions = 0, reads = 0;
+		for (i = 0; i < count; ++i) {
+			conversions += chips[i]->getConversions();
+			reads += chips[i]->getReads();
+		}
+		printf("%s: %u conversions, %u read, %llu consumed, %u dropped, "
+				"%u queued, %llu waits\n", names[policy], conversions, reads,
+				(unsigned long long) consumed, sampler.getDropped(),
+				sampler.getQueued(), (unsigned long long) thread.getBlocked());
+		printf("%s: mean age %.1f ms, %llu wakeups, %llu out of order, "
+				"%llu wrong\n", names[policy],
+				consumed ? double(age) / consumed : 0,
+				(unsigned long long) thread.getWakeups(),
+				(unsigned long long) unordered, (unsigned long long) wrong);
+		if (unordered || wrong
+				|| (policy == HX711Sampler::block && sampler.getDropped()))
+			failed = 1;
+	}
+	return failed;
+}
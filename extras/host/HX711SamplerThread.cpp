@@ -0,0 +1,128 @@
+#include <unistd.h>
+#include "HX711SamplerThread.h"
+
+/*
+ * Makes a thread for the sampler, add the scales before start
+ */
+
+HX711SamplerThread::HX711SamplerThread(HX711Sampler &sampler) :
+		_sampler(sampler) {
+	_running = false;
+	_pushed = 0;
+	_popped = 0;
+	_wakeups = 0;
+	_blocked = 0;
+}
+
+HX711SamplerThread::~HX711SamplerThread() {
+	stop();
+}
+
+/*
+ * adds a scale with its nonblocking ready file descriptor, for instance
+ * the timerfd of HX711SimChip. Returns false when the sampler is full
+ */
+bool HX711SamplerThread::add(SimpleHX711 &scale, int readyFd) {
+	uint8_t index = _sampler.getScales();
+
+	if (_running || !_sampler.add(scale))
+		return false;
+	_fds[index].fd = readyFd;
+	_fds[index].events = POLLIN;
+	return true;
+}
+
+/*
+ * starts the thread, returns false when it runs already
+ */
+bool HX711SamplerThread::start() {
+	if (_running)
+		return false;
+	_running = true;
+	_thread = std::thread(&HX711SamplerThread::run, this);
+	return true;
+}
+
+/*
+ * stops the thread, consumers waiting in pop return
+ */
+void HX711SamplerThread::stop() {
+	if (!_running)
+		return;
+	_running = false;
+	_popped.fetch_add(1);
+	_popped.notify_all();
+	_pushed.fetch_add(1);
+	_pushed.notify_all();
+	_thread.join();
+}
+
+/*
+ * takes the oldest record, with wait (the default) it waits until
+ * there is one. Returns false when there is none and the thread is
+ * stopped, records queued while it stopped are popped without wait
+ */
+bool HX711SamplerThread::pop(HX711SamplerRecord &record, bool wait) {
+	uint32_t pushed;
+	bool running;
+
+	for (;;) {
+		pushed = _pushed.load();
+		running = _running;
+		if (_sampler.pop(record)) {
+			_popped.fetch_add(1);
+			_popped.notify_one();
+			return true;
+		}
+		if (!wait || !running)
+			return false;
+		/*
+		 * sleeps until the sampler pushes, a push after the load
+		 * of pushed changes it so the wait returns at once
+		 */
+		_pushed.wait(pushed);
+	}
+}
+
+/*
+ * returns the amount of times the thread woke up
+ */
+uint64_t HX711SamplerThread::getWakeups() {
+	return _wakeups;
+}
+
+/*
+ * returns the amount of times the block policy made the thread wait
+ */
+uint64_t HX711SamplerThread::getBlocked() {
+	return _blocked;
+}
+
+void HX711SamplerThread::run() {
+	uint8_t buffer[256], i, count = _sampler.getScales();
+	uint32_t popped;
+
+	while (_running) {
+		/*
+		 * the timeout gives read() the chance to report timedOut
+		 */
+		if (poll(_fds, count, 100) < 0)
+			continue;
+		++_wakeups;
+		for (i = 0; i < count; ++i)
+			if (_fds[i].revents & POLLIN)
+				while (read(_fds[i].fd, buffer, sizeof(buffer)) > 0)
+					;
+		for (;;) {
+			popped = _popped.load();
+			if (_sampler.service()) {
+				_pushed.fetch_add(1);
+				_pushed.notify_all();
+			}
+			if (!_sampler.isBlocked() || !_running)
+				break;
+			++_blocked;
+			_popped.wait(popped);
+		}
+	}
+}
@@ -0,0 +1,54 @@
+#ifndef HX711SAMPLERTHREAD_H
+#define HX711SAMPLERTHREAD_H
+
+/*
+ * Runs an HX711Sampler in a std::thread on a host, it wakes on the
+ * ready file descriptors of the scales.
+ *
+ * Copyright (C) 2016 Edwin Croissant
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * See the README.md file for additional information.
+ */
+
+#include <atomic>
+#include <poll.h>
+#include <thread>
+#include "HX711Sampler.h"
+
+class HX711SamplerThread {
+public:
+	HX711SamplerThread(HX711Sampler &sampler);
+	~HX711SamplerThread();
+	bool add(SimpleHX711 &scale, int readyFd);
+	bool start();
+	void stop();
+	bool pop(HX711SamplerRecord &record, bool wait = true);
+	uint64_t getWakeups();
+	uint64_t getBlocked();
+
+private:
+	void run();
+	HX711Sampler &_sampler;
+	std::thread _thread;
+	std::atomic<bool> _running;
+	std::atomic<uint32_t> _pushed;
+	std::atomic<uint32_t> _popped;
+	struct pollfd _fds[HX711SAMPLER_SCALES];
+	uint64_t _wakeups;
+	uint64_t _blocked;
+};
+
+#endif //  HX711SAMPLERTHREAD_H
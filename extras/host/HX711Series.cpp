@@ -0,0 +1,369 @@
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "HX711Series.h"
+
+/*
+ * appends a value as a zig-zag LEB128 varint, 7 bits per byte
+ * with the high bit set on all but the last byte
+ */
+static void putVarint(std::vector<uint8_t> &out, int64_t value) {
+	uint64_t zigZag = (uint64_t(value) << 1) ^ uint64_t(value >> 63);
+	while (zigZag >= 0x80) {
+		out.push_back(uint8_t(zigZag) | 0x80);
+		zigZag >>= 7;
+	}
+	out.push_back(uint8_t(zigZag));
+}
+
+/*
+ * decodes a varint that ends before end, returns false when it doesn't
+ */
+static bool getVarint(const uint8_t *&in, const uint8_t *end, int64_t &value) {
+	uint64_t zigZag = 0;
+	uint8_t shift = 0;
+	while (in < end && *in & 0x80) {
+		if (shift < 64)
+			zigZag |= uint64_t(*in & 0x7F) << shift;
+		++in;
+		shift += 7;
+	}
+	if (in == end)
+		return false;
+	if (shift < 64)
+		zigZag |= uint64_t(*in) << shift;
+	++in;
+	value = int64_t(zigZag >> 1) ^ -int64_t(zigZag & 1);
+	return true;
+}
+
+HX711SeriesWriter::HX711SeriesWriter() {
+	_file = NULL;
+	_chunkSize = HX711SERIES_CHUNK;
+	_offset = 0;
+	_samples = 0;
+	_started = false;
+	_lastMillis = 0;
+	_epoch = 0;
+}
+
+HX711SeriesWriter::~HX711SeriesWriter() {
+	close();
+}
+
+/*
+ * creates the file, chunkSize is optional and defaults
+ * to HX711SERIES_CHUNK samples
+ */
+bool HX711SeriesWriter::open(const char *name, uint32_t chunkSize) {
+	HX711SeriesHeader header;
+
+	close();
+	_file = fopen(name, "wb");
+	if (!_file)
+		return false;
+	_chunkSize = chunkSize ? chunkSize : 1;
+	_samples = 0;
+	_started = false;
+	_epoch = 0;
+	_chunk.clear();
+	_index.clear();
+	/*
+	 * the header is written again by close() when the index is known
+	 */
+	memset(&header, 0, sizeof(header));
+	_offset = fwrite(&header, 1, sizeof(header), _file);
+	return _offset == sizeof(header);
+}
+
+/*
+ * adds a sample with the 32 bit millis timestamp of SimpleHX711,
+ * the wrap around after 49 days is removed
+ */
+bool HX711SeriesWriter::add(int32_t raw, uint32_t timestamp) {
+	if (_started && timestamp < _lastMillis
+			&& _lastMillis - timestamp > 0x80000000u)
+		_epoch += uint64_t(1) << 32;
+	_started = true;
+	_lastMillis = timestamp;
+	return add64(raw, _epoch + timestamp);
+}
+
+/*
+ * adds a sample with a 64 bit millis timestamp
+ */
+bool HX711SeriesWriter::add64(int32_t raw, uint64_t timestamp) {
+	HX711SeriesSample sample;
+
+	if (!_file)
+		return false;
+	sample.timestamp = timestamp;
+	sample.raw = raw;
+	_chunk.push_back(sample);
+	++_samples;
+	return _chunk.size() < _chunkSize || writeChunk();
+}
+
+/*
+ * encodes the buffered samples as one chunk
+ */
+bool HX711SeriesWriter::writeChunk() {
+	HX711SeriesIndex index;
+	uint32_t bits = 0;
+	int64_t delta = 0, previousDelta = 0;
+	size_t i;
+
+	if (_chunk.empty())
+		return true;
+	/*
+	 * the zero bits on the right that all values have in common
+	 * are shifted out, SimpleHX711 readings have at least 8
+	 */
+	for (i = 0; i < _chunk.size(); ++i)
+		bits |= uint32_t(_chunk[i].raw);
+	memset(&index, 0, sizeof(index));
+	index.shift = bits ? __builtin_ctz(bits) : 0;
+	index.firstTimestamp = _chunk.front().timestamp;
+	index.lastTimestamp = _chunk.back().timestamp;
+	index.firstValue = _chunk.front().raw;
+	index.count = _chunk.size();
+	index.offset = _offset;
+
+	_timestamps.clear();
+	_values.clear();
+	for (i = 1; i < _chunk.size(); ++i) {
+		delta = int64_t(_chunk[i].timestamp - _chunk[i - 1].timestamp);
+		putVarint(_timestamps, delta - previousDelta);
+		previousDelta = delta;
+		putVarint(_values,
+				int64_t(_chunk[i].raw >> index.shift)
+						- int64_t(_chunk[i - 1].raw >> index.shift));
+	}
+	index.timestampBytes = _timestamps.size();
+	index.valueBytes = _values.size();
+	if (fwrite(_timestamps.data(), 1, _timestamps.size(), _file)
+			!= _timestamps.size()
+			|| fwrite(_values.data(), 1, _values.size(), _file)
+					!= _values.size())
+		return false;
+	_offset += _timestamps.size() + _values.size();
+	_index.push_back(index);
+	_chunk.clear();
+	return true;
+}
+
+/*
+ * writes the last chunk, the index and the header and closes the file
+ */
+bool HX711SeriesWriter::close() {
+	HX711SeriesHeader header;
+	bool success;
+
+	if (!_file)
+		return true;
+	success = writeChunk();
+	/*
+	 * the index is aligned so the reader can use it straight from the map
+	 */
+	while (success && _offset % 8) {
+		success = fputc(0, _file) != EOF;
+		++_offset;
+	}
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, HX711SERIES_MAGIC, sizeof(header.magic));
+	header.chunkSize = _chunkSize;
+	header.chunks = _index.size();
+	header.samples = _samples;
+	header.indexOffset = _offset;
+	success = success
+			&& fwrite(_index.data(), sizeof(HX711SeriesIndex), _index.size(),
+					_file) == _index.size()
+			&& fseek(_file, 0, SEEK_SET) == 0
+			&& fwrite(&header, sizeof(header), 1, _file) == 1;
+	success = fclose(_file) == 0 && success;
+	_file = NULL;
+	return success;
+}
+
+/*
+ * returns the amount of samples added
+ */
+uint64_t HX711SeriesWriter::getSamples() {
+	return _samples;
+}
+
+HX711SeriesReader::HX711SeriesReader() {
+	_map = NULL;
+	_size = 0;
+	_header = NULL;
+	_index = NULL;
+}
+
+HX711SeriesReader::~HX711SeriesReader() {
+	close();
+}
+
+/*
+ * maps the file in memory, the chunks are decoded straight from the map
+ * returns false when the file can't be mapped, is not a series file or
+ * has an index entry outside the chunks
+ */
+bool HX711SeriesReader::open(const char *name) {
+	struct stat status;
+	uint32_t i;
+	int file;
+	void *map;
+
+	close();
+	file = ::open(name, O_RDONLY);
+	if (file < 0)
+		return false;
+	if (fstat(file, &status) || size_t(status.st_size) < sizeof(HX711SeriesHeader)) {
+		::close(file);
+		return false;
+	}
+	map = mmap(NULL, status.st_size, PROT_READ, MAP_SHARED, file, 0);
+	::close(file);
+	if (map == MAP_FAILED)
+		return false;
+	_map = static_cast<const uint8_t*>(map);
+	_size = status.st_size;
+	_header = reinterpret_cast<const HX711SeriesHeader*>(_map);
+	if (memcmp(_header->magic, HX711SERIES_MAGIC, sizeof(_header->magic))
+			|| _header->indexOffset > _size || _header->indexOffset % 8
+			|| (_size - _header->indexOffset) / sizeof(HX711SeriesIndex)
+					< _header->chunks) {
+		close();
+		return false;
+	}
+	_index = reinterpret_cast<const HX711SeriesIndex*>(_map
+			+ _header->indexOffset);
+	/*
+	 * every chunk must lie between the header and the index, so a
+	 * truncated or corrupt file can't make readChunk leave the map
+	 */
+	for (i = 0; i < _header->chunks; ++i) {
+		const HX711SeriesIndex &index = _index[i];
+		if (!index.count || index.count > _header->chunkSize || index.shift > 31
+				|| index.offset < sizeof(HX711SeriesHeader)
+				|| index.offset > _header->indexOffset
+				|| uint64_t(index.timestampBytes) + index.valueBytes
+						> _header->indexOffset - index.offset) {
+			close();
+			return false;
+		}
+	}
+	/*
+	 * range queries jump to a chunk through the index, read ahead of
+	 * the whole file would only fill the page cache
+	 */
+	madvise(map, _size, MADV_RANDOM);
+	return true;
+}
+
+/*
+ * unmaps the file
+ */
+void HX711SeriesReader::close() {
+	if (_map)
+		munmap(const_cast<uint8_t*>(_map), _size);
+	_map = NULL;
+	_size = 0;
+	_header = NULL;
+	_index = NULL;
+}
+
+/*
+ * returns the amount of samples in the file
+ */
+uint64_t HX711SeriesReader::getSamples() {
+	return _header ? _header->samples : 0;
+}
+
+/*
+ * returns the amount of chunks in the file
+ */
+uint32_t HX711SeriesReader::getChunks() {
+	return _header ? _header->chunks : 0;
+}
+
+/*
+ * returns the index of a chunk, the caller checks the chunk exists
+ */
+const HX711SeriesIndex &HX711SeriesReader::getIndex(uint32_t chunk) {
+	return _index[chunk];
+}
+
+/*
+ * decodes a chunk, samples must have room for the count of the chunk
+ * returns the amount of samples decoded, less than the count when a
+ * column ends early
+ */
+size_t HX711SeriesReader::readChunk(uint32_t chunk,
+		HX711SeriesSample *samples) {
+	const HX711SeriesIndex &index = _index[chunk];
+	const uint8_t *timestamps = _map + index.offset;
+	const uint8_t *values = timestamps + index.timestampBytes;
+	const uint8_t *end = values + index.valueBytes;
+	uint64_t timestamp = index.firstTimestamp;
+	int64_t delta = 0, timestampVarint, valueVarint;
+	int32_t shifted = index.firstValue >> index.shift;
+	uint32_t i;
+
+	samples[0].timestamp = timestamp;
+	samples[0].raw = index.firstValue;
+	for (i = 1; i < index.count; ++i) {
+		if (!getVarint(timestamps, values, timestampVarint)
+				|| !getVarint(values, end, valueVarint))
+			return i;
+		delta += timestampVarint;
+		timestamp += delta;
+		shifted += valueVarint;
+		samples[i].timestamp = timestamp;
+		samples[i].raw = uint32_t(shifted) << index.shift;
+	}
+	return index.count;
+}
+
+/*
+ * appends the samples with a timestamp from up to and including to,
+ * returns the amount of samples appended
+ */
+size_t HX711SeriesReader::read(uint64_t from, uint64_t to,
+		std::vector<HX711SeriesSample> &samples) {
+	uint32_t low = 0, high = getChunks(), chunk, i, count;
+	size_t start = samples.size();
+	std::vector<HX711SeriesSample> buffer;
+
+	/*
+	 * binary search for the first chunk that ends at or after from
+	 */
+	while (low < high) {
+		chunk = (low + high) / 2;
+		if (_index[chunk].lastTimestamp < from)
+			low = chunk + 1;
+		else
+			high = chunk;
+	}
+	for (chunk = low; chunk < getChunks() && _index[chunk].firstTimestamp <= to;
+			++chunk) {
+		if (_index[chunk].firstTimestamp >= from
+				&& _index[chunk].lastTimestamp <= to) {
+			/*
+			 * the whole chunk is in the range so decode it in place
+			 */
+			count = samples.size();
+			samples.resize(count + _index[chunk].count);
+			samples.resize(count + readChunk(chunk, &samples[count]));
+			continue;
+		}
+		buffer.resize(_index[chunk].count);
+		buffer.resize(readChunk(chunk, buffer.data()));
+		for (i = 0; i < buffer.size(); ++i)
+			if (buffer[i].timestamp >= from && buffer[i].timestamp <= to)
+				samples.push_back(buffer[i]);
+	}
+	return samples.size() - start;
+}
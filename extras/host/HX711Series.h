@@ -0,0 +1,112 @@
+#ifndef HX711SERIES_H
+#define HX711SERIES_H
+
+/*
+ * Columnar time series file for SimpleHX711 samples, for the host.
+ *
+ * Copyright (C) 2016 Edwin Croissant
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * See the README.md file for additional information.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <vector>
+
+/*
+ * The file starts with an HX711SeriesHeader, followed by the chunks and
+ * the index, an HX711SeriesIndex for every chunk. A chunk holds up to
+ * chunkSize samples as two columns of zig-zag LEB128 varints: the
+ * timestamps as the difference of their deltas and the values shifted
+ * right by the chunk shift as deltas. The first timestamp and value of a
+ * chunk are in the index so every chunk decodes on its own.
+ * Timestamps are 64 bit millis, the 32 bit millis of the Arduino are
+ * unwrapped by the writer. All numbers are little endian.
+ */
+#define HX711SERIES_MAGIC "HX711TS1"
+#define HX711SERIES_CHUNK 4096
+
+struct HX711SeriesHeader {
+	char magic[8];
+	uint32_t chunkSize;
+	uint32_t chunks;
+	uint64_t samples;
+	uint64_t indexOffset;
+};
+
+struct HX711SeriesIndex {
+	uint64_t firstTimestamp;
+	uint64_t lastTimestamp;
+	uint64_t offset;
+	int32_t firstValue;
+	uint32_t count;
+	uint32_t timestampBytes;
+	uint32_t valueBytes;
+	uint8_t shift;
+	uint8_t reserved[7];
+};
+
+struct HX711SeriesSample {
+	uint64_t timestamp;
+	int32_t raw;
+};
+
+class HX711SeriesWriter {
+public:
+	HX711SeriesWriter();
+	~HX711SeriesWriter();
+	bool open(const char *name, uint32_t chunkSize = HX711SERIES_CHUNK);
+	bool add(int32_t raw, uint32_t timestamp);
+	bool add64(int32_t raw, uint64_t timestamp);
+	bool close();
+	uint64_t getSamples();
+
+private:
+	bool writeChunk();
+	FILE *_file;
+	uint32_t _chunkSize;
+	uint64_t _offset;
+	uint64_t _samples;
+	bool _started;
+	uint32_t _lastMillis;
+	uint64_t _epoch;
+	std::vector<HX711SeriesSample> _chunk;
+	std::vector<HX711SeriesIndex> _index;
+	std::vector<uint8_t> _timestamps;
+	std::vector<uint8_t> _values;
+};
+
+class HX711SeriesReader {
+public:
+	HX711SeriesReader();
+	~HX711SeriesReader();
+	bool open(const char *name);
+	void close();
+	uint64_t getSamples();
+	uint32_t getChunks();
+	const HX711SeriesIndex &getIndex(uint32_t chunk);
+	size_t readChunk(uint32_t chunk, HX711SeriesSample *samples);
+	size_t read(uint64_t from, uint64_t to,
+			std::vector<HX711SeriesSample> &samples);
+
+private:
+	const uint8_t *_map;
+	size_t _size;
+	const HX711SeriesHeader *_header;
+	const HX711SeriesIndex *_index;
+};
+
+#endif //  HX711SERIES_H
@@ -0,0 +1,231 @@
+/*
+ * Converts, queries and benchmarks HX711Series files.
+ *
+ * Build from this directory with:
+ *   g++ -O2 -I../../src HX711SeriesTool.cpp HX711Series.cpp HX711Pyramid.cpp -o HX711SeriesTool
+ * Usage:
+ *   HX711SeriesTool convert log.bin out.hts   replays a log of HX711Logger
+ *   HX711SeriesTool query in.hts from to      prints the samples as csv
+ *   HX711SeriesTool summary in.hts from to    prints min, max and mean
+ *   HX711SeriesTool bench out.hts samples     writes a simulated 80 SPS
+ *                                             recording and times queries
+ * convert and bench write the min, max and mean pyramid of the recording
+ * next to it, with .hpy added to the name.
+ */
+
+#include <chrono>
+#include <random>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include "HX711Logger.h"
+#include "HX711Pyramid.h"
+#include "HX711Series.h"
+
+/*
+ * the longest window in millis checked against a scan of the samples,
+ * about 8 M samples, the scan keeps them all in memory
+ */
+#define HX711SERIESTOOL_CHECK 100000000ULL
+
+static double since(std::chrono::steady_clock::time_point start) {
+	return std::chrono::duration<double>(
+			std::chrono::steady_clock::now() - start).count();
+}
+
+/*
+ * the name of the pyramid of a recording
+ */
+static std::string pyramidName(const char *name) {
+	return std::string(name) + ".hpy";
+}
+
+static int convert(const char *in, const char *out) {
+	HX711LogBlock block;
+	HX711SeriesWriter writer;
+	HX711Pyramid pyramid;
+	uint32_t last = 0;
+	uint64_t epoch = 0;
+	FILE *file = fopen(in, "rb");
+	if (!file) {
+		perror(in);
+		return 1;
+	}
+	if (!writer.open(out)) {
+		perror(out);
+		fclose(file);
+		return 1;
+	}
+	while (fread(&block, sizeof(block), 1, file) == 1)
+		for (uint16_t i = 0; i < block.count && i < HX711LOGGER_SAMPLES; ++i) {
+			const HX711Sample &sample = block.samples[i];
+			writer.add(sample.raw, sample.timestamp);
+			/*
+			 * unwrap the millis in the same way as the writer
+			 */
+			if (sample.timestamp < last && last - sample.timestamp > 0x80000000u)
+				epoch += uint64_t(1) << 32;
+			last = sample.timestamp;
+			pyramid.add(epoch + sample.timestamp, sample.raw);
+		}
+	fclose(file);
+	if (!writer.close() || !pyramid.save(pyramidName(out).c_str())) {
+		perror(out);
+		return 1;
+	}
+	printf("%llu samples written\n", (unsigned long long) writer.getSamples());
+	return 0;
+}
+
+static int query(const char *in, uint64_t from, uint64_t to) {
+	HX711SeriesReader reader;
+	std::vector<HX711SeriesSample> samples;
+	if (!reader.open(in)) {
+		fprintf(stderr, "%s: not a series file\n", in);
+		return 1;
+	}
+	reader.read(from, to, samples);
+	for (size_t i = 0; i < samples.size(); ++i)
+		printf("%llu,%ld\n", (unsigned long long) samples[i].timestamp,
+				(long) samples[i].raw);
+	return 0;
+}
+
+static int summary(const char *in, uint64_t from, uint64_t to) {
+	HX711SeriesReader reader;
+	HX711Pyramid pyramid;
+	if (!reader.open(in) || !pyramid.load(pyramidName(in).c_str())) {
+		fprintf(stderr, "%s: not a series file with a pyramid\n", in);
+		return 1;
+	}
+	HX711Summary result = pyramid.summarise(from, to, &reader);
+	printf("%llu samples, min %ld, max %ld, mean %.1f\n",
+			(unsigned long long) result.count, (long) result.min,
+			(long) result.max, result.getMean());
+	return 0;
+}
+
+static int bench(const char *out, uint64_t count) {
+	HX711SeriesWriter writer;
+	HX711SeriesReader reader;
+	HX711Pyramid pyramid;
+	std::vector<HX711SeriesSample> samples;
+	std::mt19937_64 generator(711);
+	std::normal_distribution<double> noise(0, 20);
+	uint64_t i, total = 0;
+	double load = 0;
+
+	if (!writer.open(out)) {
+		perror(out);
+		return 1;
+	}
+	auto start = std::chrono::steady_clock::now();
+	for (i = 0; i < count; ++i) {
+		if (i % 4800 == 0)
+			load = generator() % 400000;
+		int32_t raw = int32_t(100000 + load + noise(generator)) * 256;
+		writer.add(raw, uint32_t(i * 25 / 2));
+		pyramid.add(i * 25 / 2, raw);
+	}
+	if (!writer.close() || !pyramid.save(pyramidName(out).c_str())) {
+		perror(out);
+		return 1;
+	}
+	double seconds = since(start);
+	if (!reader.open(out)) {
+		fprintf(stderr, "%s: not a series file\n", out);
+		return 1;
+	}
+	FILE *file = fopen(out, "rb");
+	fseek(file, 0, SEEK_END);
+	double bytes = ftell(file);
+	fclose(file);
+	file = fopen(pyramidName(out).c_str(), "rb");
+	fseek(file, 0, SEEK_END);
+	double pyramidBytes = ftell(file);
+	fclose(file);
+	printf("wrote %llu samples in %.2f s, %.2f bytes per sample, %.1f MB\n",
+			(unsigned long long) count, seconds, bytes / count, bytes / 1e6);
+	printf("pyramid %.0f bytes, %.1f %% of the recording\n", pyramidBytes,
+			pyramidBytes / bytes * 100);
+
+	/*
+	 * random one minute windows, then a scan of everything
+	 */
+	uint64_t span = count * 25 / 2;
+	start = std::chrono::steady_clock::now();
+	for (i = 0; i < 10000; ++i) {
+		uint64_t from = generator() % (span ? span : 1);
+		samples.clear();
+		total += reader.read(from, from + 60000, samples);
+	}
+	seconds = since(start);
+	printf("10000 one minute queries: %.1f us per query, %.0f samples each\n",
+			seconds * 1e6 / 10000, total / 10000.0);
+
+	start = std::chrono::steady_clock::now();
+	samples.resize(reader.getChunks() ? reader.getIndex(0).count : 0);
+	for (total = 0, i = 0; i < reader.getChunks(); ++i)
+		total += reader.readChunk(i, samples.data());
+	seconds = since(start);
+	printf("full scan: %.1f M samples/s, %.1f MB/s\n", total / seconds / 1e6,
+			bytes / seconds / 1e6);
+
+	/*
+	 * random windows of up to the whole recording summarised with the
+	 * pyramid, a few shorter ones are checked against a scan of the samples
+	 */
+	uint64_t errors = 0;
+	for (i = 0; i < 10; ++i) {
+		uint64_t from = generator() % (span ? span : 1);
+		uint64_t to = from + generator() % ((span - from < HX711SERIESTOOL_CHECK ?
+				span - from : HX711SERIESTOOL_CHECK) + 1);
+		HX711Summary fast = pyramid.summarise(from, to, &reader);
+		HX711Summary exact;
+		exact.begin();
+		samples.clear();
+		reader.read(from, to, samples);
+		for (size_t j = 0; j < samples.size(); ++j)
+			exact.add(samples[j].timestamp, samples[j].raw);
+		errors += exact.count != fast.count || exact.sum != fast.sum
+				|| exact.min != fast.min || exact.max != fast.max;
+	}
+	start = std::chrono::steady_clock::now();
+	for (i = 0; i < 10000; ++i) {
+		uint64_t from = generator() % (span ? span : 1);
+		uint64_t to = from + generator() % (span - from + 1);
+		total += pyramid.summarise(from, to, &reader).count;
+	}
+	seconds = since(start);
+	start = std::chrono::steady_clock::now();
+	for (i = 0; i < 10000; ++i) {
+		uint64_t from = generator() % (span ? span : 1);
+		uint64_t to = from + generator() % (span - from + 1);
+		total += pyramid.summarise(from, to).count;
+	}
+	printf("%u levels, pyramid summaries: %.1f us per window exact, "
+			"%.1f us to leaf resolution, %llu errors\n", pyramid.getLevels(),
+			seconds * 1e6 / 10000, since(start) * 1e6 / 10000,
+			(unsigned long long) errors);
+	return errors != 0;
+}
+
+int main(int argc, char *argv[]) {
+	if (argc == 4 && !strcmp(argv[1], "convert"))
+		return convert(argv[2], argv[3]);
+	if (argc == 5 && !strcmp(argv[1], "query"))
+		return query(argv[2], strtoull(argv[3], NULL, 0),
+				strtoull(argv[4], NULL, 0));
+	if (argc == 5 && !strcmp(argv[1], "summary"))
+		return summary(argv[2], strtoull(argv[3], NULL, 0),
+				strtoull(argv[4], NULL, 0));
+	if (argc == 4 && !strcmp(argv[1], "bench"))
+		return bench(argv[2], strtoull(argv[3], NULL, 0));
+	fprintf(stderr, "usage: %s convert log.bin out.hts\n"
+			"       %s query in.hts from to\n"
+			"       %s summary in.hts from to\n"
+			"       %s bench out.hts samples\n", argv[0], argv[0], argv[0],
+			argv[0]);
+	return 1;
+}
@@ -0,0 +1,90 @@
+/*
+ * Reads banks of simulated HX711 chips through a simulated chain of
+ * 74HC165 shift registers with HX711ShiftBank, checks the readings and
+ * reports the read time and the highest sample rate. Before every read
+ * another device uses the bus in mode 0, like an SD card, so the bank
+ * switches the clock polarity every time.
+ *
+ * Build and run from this directory with:
+ *   g++ -O2 -I. -I../../src HX711ShiftBench.cpp HX711SimShift.cpp \
+ *       HX711SimChip.cpp ../../src/HX711ShiftBank.cpp \
+ *       ../../src/HX711Transpose.cpp -o HX711ShiftBench
+ *   ./HX711ShiftBench 80
+ * the argument is the data rate of the chips in Hz.
+ */
+
+#include <memory>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+#include "HX711ShiftBank.h"
+#include "HX711SimChip.h"
+#include "HX711SimShift.h"
+
+/*
+ * the pins of the emulated board, the data lines follow DATA
+ */
+#define CLOCK 2
+#define LOAD 3
+#define DATA 16
+
+static const uint8_t counts[] = { 1, 8, 9, 16, 24, 31, 32 };
+
+int main(int argc, char *argv[]) {
+	uint32_t rate = argc > 1 ? strtoul(argv[1], NULL, 0) : 80;
+	uint8_t size, count, chip, reads;
+	uint32_t start;
+	int failures = 0;
+
+	for (size = 0; size < sizeof(counts) / sizeof(counts[0]); ++size) {
+		std::vector<std::unique_ptr<HX711SimChip> > chips;
+		int32_t raw[HX711SHIFTBANK_LINES];
+		uint32_t slowest = 0, failed = 0;
+		bool correct = true;
+
+		count = counts[size];
+		for (chip = 0; chip < count; ++chip) {
+			chips.emplace_back(new HX711SimChip(CLOCK, DATA + chip, rate));
+			chips.back()->setValue(8388607 - 524309 * chip);
+		}
+		HX711SimShift shift(LOAD, DATA, count);
+		HX711ShiftBank bank(SPI, CLOCK, LOAD, count);
+		if (!bank.begin())
+			return 1;
+		for (reads = 0; reads < 3;) {
+			start = millis();
+			while (!bank.isReady())
+				if (millis() - start > 1000) {
+					/*
+					 * the simulation allows a longer clock high than
+					 * the real chip before it powers down
+					 */
+					bank.powerDown();
+					delayMicroseconds(2000);
+					bank.powerUp();
+					start = millis();
+				}
+			SPI.beginTransaction(SPISettings(4000000, MSBFIRST, SPI_MODE0));
+			SPI.transfer(0);
+			SPI.endTransaction();
+			if (!bank.read(raw)) {
+				++failed;
+				continue;
+			}
+			++reads;
+			if (bank.getTiming().read > slowest)
+				slowest = bank.getTiming().read;
+			for (chip = 0; chip < count; ++chip)
+				if (raw[chip] >> 8 != 8388607 - 524309 * chip)
+					correct = false;
+		}
+		if (!correct)
+			++failures;
+		printf("%2u scales: read %4lu us, at most %5.0f samples/s", count,
+				(unsigned long) slowest, 1e6 / slowest);
+		if (failed)
+			printf(", %lu failed", (unsigned long) failed);
+		printf("%s\n", correct ? "" : " WRONG");
+	}
+	return failures ? 1 : 0;
+}
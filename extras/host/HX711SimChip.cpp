@@ -0,0 +1,280 @@
+#include <math.h>
+#include <sys/timerfd.h>
+#include <time.h>
+#include <unistd.h>
+#include "Arduino.h"
+#include "HX711SimChip.h"
+
+/*
+ * the real chip powers down after 60 us, a host can be preempted
+ * for longer than that so the simulation allows more
+ */
+#define HX711SIMCHIP_POWERDOWN 1000000
+
+/*
+ * the chips by their clock and data pins and the level of every pin,
+ * chips that share a clock pin are chained with _shared
+ */
+static HX711SimChip *clockPins[HX711SIMCHIP_PINS];
+static HX711SimChip *dataPins[HX711SIMCHIP_PINS];
+static uint8_t levels[HX711SIMCHIP_PINS];
+
+/*
+ * other simulated parts that watch a pin
+ */
+static void (*hooks[HX711SIMCHIP_PINS])(void *context, bool high);
+static void *hookContexts[HX711SIMCHIP_PINS];
+
+static uint64_t nanos() {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return uint64_t(now.tv_sec) * 1000000000 + now.tv_nsec;
+}
+
+/*
+ * millis and micros count from the first call, which may come from
+ * the constructor of a global SimpleHX711
+ */
+static uint64_t elapsed() {
+	static uint64_t start = nanos();
+	return nanos() - start;
+}
+
+void pinMode(uint8_t pin, uint8_t mode) {
+	if (mode == INPUT_PULLUP)
+		levels[pin] = HIGH;
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+	HX711SimChip *chip;
+
+	levels[pin] = value ? HIGH : LOW;
+	for (chip = clockPins[pin]; chip; chip = chip->_shared)
+		chip->clock(value);
+	if (hooks[pin])
+		hooks[pin](hookContexts[pin], value);
+}
+
+int digitalRead(uint8_t pin) {
+	if (dataPins[pin])
+		return dataPins[pin]->data() ? HIGH : LOW;
+	return levels[pin];
+}
+
+unsigned long millis() {
+	return elapsed() / 1000000;
+}
+
+unsigned long micros() {
+	return elapsed() / 1000;
+}
+
+void delayMicroseconds(unsigned int us) {
+	struct timespec duration = { 0, long(us) * 1000 };
+	nanosleep(&duration, NULL);
+}
+
+void noInterrupts() {
+}
+
+void interrupts() {
+}
+
+/*
+ * Makes a chip on the clock and data pins of the emulated board. It
+ * converts continuously at dataRate Hz, which is optional and defaults
+ * to 10, the first conversion is ready after one period
+ */
+
+HX711SimChip::HX711SimChip(uint8_t pinClk, uint8_t pinData,
+		uint32_t dataRate) {
+	_pinClk = pinClk;
+	_pinData = pinData;
+	_period = 1000000000ULL / (dataRate ? dataRate : 10);
+	_made = nanos();
+	_next = _made + _period;
+	_rising = 0;
+	_pulse = 0;
+	_clock = false;
+	_poweredDown = false;
+	_latched = 0;
+	_start = 0;
+	_target = 0;
+	_loaded = 0;
+	_tau = 0;
+	_noise = 0;
+	_random = pinData * 2654435761u + 1;
+	_reads = 0;
+	_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+	_shared = clockPins[pinClk];
+	clockPins[pinClk] = this;
+	dataPins[pinData] = this;
+	finish(0);
+}
+
+HX711SimChip::~HX711SimChip() {
+	HX711SimChip **chip;
+
+	for (chip = &clockPins[_pinClk]; *chip; chip = &(*chip)->_shared)
+		if (*chip == this) {
+			*chip = _shared;
+			break;
+		}
+	dataPins[_pinData] = NULL;
+	if (_fd >= 0)
+		close(_fd);
+}
+
+/*
+ * calls hook on every write to the pin, for simulating other parts of
+ * the board. NULL removes it
+ */
+void HX711SimChip::setPinHook(uint8_t pin,
+		void (*hook)(void *context, bool high), void *context) {
+	hooks[pin] = hook;
+	hookContexts[pin] = context;
+}
+
+/*
+ * sets the 24 bit reading at once
+ */
+void HX711SimChip::setValue(int32_t value) {
+	setLoad(value, 0);
+}
+
+/*
+ * places a load, the reading settles to value exponentially
+ * with a time constant of tau ms
+ */
+void HX711SimChip::setLoad(int32_t value, uint32_t tau) {
+	_start = settled(nanos());
+	_target = value;
+	_loaded = nanos();
+	_tau = tau;
+}
+
+/*
+ * sets the peak to peak noise added to every reading
+ */
+void HX711SimChip::setNoise(int32_t noise) {
+	_noise = noise;
+}
+
+/*
+ * returns a nonblocking timerfd that is readable when a conversion is
+ * ready, it stands in for the DOUT interrupt of a board
+ */
+int HX711SimChip::getReadyFd() {
+	return _fd;
+}
+
+/*
+ * returns true when a conversion is ready, DOUT low
+ */
+bool HX711SimChip::isReady() {
+	return !_poweredDown && !_clock && (_pulse == 0 || _pulse >= 25)
+			&& nanos() >= _next;
+}
+
+/*
+ * returns the amount of conversions since the chip was made
+ */
+uint32_t HX711SimChip::getConversions() {
+	return (nanos() - _made) / _period;
+}
+
+/*
+ * returns the amount of conversions read
+ */
+uint32_t HX711SimChip::getReads() {
+	return _reads;
+}
+
+/*
+ * the reading at the time without noise
+ */
+double HX711SimChip::settled(uint64_t now) {
+	if (!_tau)
+		return _target;
+	return _target
+			+ (_start - _target) * exp(-double(now - _loaded) / 1e6 / _tau);
+}
+
+/*
+ * the reading at the time with noise
+ */
+int32_t HX711SimChip::sample(uint64_t now) {
+	double value = settled(now);
+
+	if (_noise) {
+		_random = _random * 1664525 + 1013904223;
+		value += int32_t(_random % uint32_t(_noise)) - _noise / 2;
+	}
+	return constrain(int32_t(value), -8388608, 8388607);
+}
+
+/*
+ * the conversion was read, the next one is ready at the next
+ * multiple of the period
+ */
+void HX711SimChip::finish(uint64_t now) {
+	struct itimerspec timer;
+
+	if (now >= _next)
+		_next += ((now - _next) / _period + 1) * _period;
+	memset(&timer, 0, sizeof(timer));
+	timer.it_value.tv_sec = _next / 1000000000;
+	timer.it_value.tv_nsec = _next % 1000000000;
+	timerfd_settime(_fd, TFD_TIMER_ABSTIME, &timer, NULL);
+}
+
+/*
+ * a rising edge shifts out the next bit, the pulses after the 24th
+ * select the gain. A long clock high powers the chip down,
+ * a falling edge after it resets the chip
+ */
+void HX711SimChip::clock(bool high) {
+	uint64_t now = nanos();
+
+	if (high == _clock)
+		return;
+	_clock = high;
+	if (high) {
+		_rising = now;
+		if (_pulse >= 25 && now >= _next)
+			_pulse = 0;
+		if (!_pulse)
+			_latched = sample(now);
+		if (_pulse < 255)
+			++_pulse;
+		return;
+	}
+	if (_poweredDown || now - _rising > HX711SIMCHIP_POWERDOWN) {
+		/*
+		 * the first conversion after a reset takes 400 ms
+		 */
+		_poweredDown = false;
+		_pulse = 0;
+		_next = now + 400000000;
+		finish(now);
+		return;
+	}
+	if (_pulse == 25) {
+		++_reads;
+		finish(now);
+	}
+}
+
+/*
+ * returns the level of DOUT: the bit of the reading while clocking, it
+ * stays until the next rising edge, otherwise low when a conversion is ready
+ */
+bool HX711SimChip::data() {
+	if (_clock && nanos() - _rising > HX711SIMCHIP_POWERDOWN)
+		_poweredDown = true;
+	if (_poweredDown)
+		return true;
+	if (_pulse && _pulse <= 24)
+		return (_latched >> (24 - _pulse)) & 1;
+	return !isReady();
+}
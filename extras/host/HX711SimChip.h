@@ -0,0 +1,76 @@
+#ifndef HX711SIMCHIP_H
+#define HX711SIMCHIP_H
+
+/*
+ * Simulated HX711 behind the host Arduino API, for running SimpleHX711
+ * on a host. The chip converts continuously and signals a ready
+ * conversion with a timerfd, like a DOUT interrupt.
+ *
+ * Copyright (C) 2016 Edwin Croissant
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * See the README.md file for additional information.
+ */
+
+#include <stdint.h>
+
+/*
+ * the amount of pins of the emulated board
+ */
+#define HX711SIMCHIP_PINS 256
+
+class HX711SimChip {
+public:
+	HX711SimChip(uint8_t pinClk, uint8_t pinData, uint32_t dataRate = 10);
+	~HX711SimChip();
+	void setValue(int32_t value);
+	void setLoad(int32_t value, uint32_t tau);
+	void setNoise(int32_t noise);
+	int getReadyFd();
+	bool isReady();
+	uint32_t getConversions();
+	uint32_t getReads();
+	void clock(bool high);
+	bool data();
+	static void setPinHook(uint8_t pin, void (*hook)(void *context, bool high),
+			void *context);
+
+private:
+	double settled(uint64_t now);
+	int32_t sample(uint64_t now);
+	void finish(uint64_t now);
+	uint8_t _pinClk;
+	uint8_t _pinData;
+	uint64_t _period;
+	uint64_t _made;
+	uint64_t _next;
+	uint64_t _rising;
+	uint8_t _pulse;
+	bool _clock;
+	bool _poweredDown;
+	int32_t _latched;
+	double _start;
+	int32_t _target;
+	uint64_t _loaded;
+	uint32_t _tau;
+	int32_t _noise;
+	uint32_t _random;
+	int _fd;
+	uint32_t _reads;
+	HX711SimChip *_shared;
+	friend void digitalWrite(uint8_t pin, uint8_t value);
+};
+
+#endif //  HX711SIMCHIP_H
@@ -0,0 +1,128 @@
+#include <time.h>
+#include "HX711SimExpander.h"
+
+/*
+ * 9 bits a byte and about one more for the start and stop
+ */
+#define HX711SIMEXPANDER_BYTE 9
+#define HX711SIMEXPANDER_FRAME 2
+
+static uint64_t nanos() {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return uint64_t(now.tv_sec) * 1000000000 + now.tv_nsec;
+}
+
+/*
+ * Makes an expander on the pins base to base + 15 with a bus of busHz
+ */
+
+HX711SimExpander::HX711SimExpander(uint8_t base, uint32_t busHz) {
+	_base = base;
+	_busHz = busHz ? busHz : 100000;
+	_outputs = 0;
+	_levels = 0;
+	_transactions = 0;
+}
+
+/*
+ * waits the time the bus takes for the bits, a busy wait as sleeping
+ * takes far longer than a few us
+ */
+void HX711SimExpander::transfer(uint16_t bits) {
+	uint64_t until = nanos() + uint64_t(bits) * 1000000000 / _busHz;
+
+	while (nanos() < until)
+		;
+}
+
+/*
+ * drives the outputs
+ */
+void HX711SimExpander::set(uint16_t levels) {
+	uint8_t pin;
+
+	for (pin = 0; pin < 16; ++pin)
+		if (((_outputs >> pin) & 1) && (((_levels ^ levels) >> pin) & 1))
+			digitalWrite(_base + pin, (levels >> pin) & 1);
+	_levels = levels;
+}
+
+/*
+ * the outputs are low, the other pins are inputs with pull ups
+ */
+bool HX711SimExpander::setup(uint16_t outputs) {
+	uint8_t pin;
+
+	++_transactions;
+	transfer(HX711SIMEXPANDER_FRAME + 4 * HX711SIMEXPANDER_BYTE);
+	_outputs = outputs;
+	for (pin = 0; pin < 16; ++pin)
+		if (!((outputs >> pin) & 1))
+			pinMode(_base + pin, INPUT_PULLUP);
+	_levels = 0xFFFF;
+	set(0);
+	return true;
+}
+
+/*
+ * sets the outputs, the address, the register and two bytes
+ */
+bool HX711SimExpander::write(uint16_t levels) {
+	++_transactions;
+	transfer(HX711SIMEXPANDER_FRAME + 3 * HX711SIMEXPANDER_BYTE);
+	set(levels);
+	transfer(HX711SIMEXPANDER_BYTE);
+	return true;
+}
+
+/*
+ * pulses the pins count times in one transaction, they are high for the
+ * time of two bytes. Returns the longest time they were high in us, which
+ * is longer than the bus time when the host was busy
+ */
+uint16_t HX711SimExpander::pulse(uint16_t pins, uint8_t count) {
+	uint64_t high, longest = 0;
+	uint8_t i;
+
+	++_transactions;
+	transfer(HX711SIMEXPANDER_FRAME + 3 * HX711SIMEXPANDER_BYTE);
+	for (i = 0; i < count; ++i) {
+		set(_levels | pins);
+		high = nanos();
+		transfer(2 * HX711SIMEXPANDER_BYTE);
+		high = nanos() - high;
+		set(_levels & ~pins);
+		if (high > longest)
+			longest = high;
+		transfer(2 * HX711SIMEXPANDER_BYTE);
+	}
+	longest /= 1000;
+	return longest < 0xFFFF ? longest : 0xFFFE;
+}
+
+/*
+ * reads all pins, the register is written and after a repeated start
+ * two bytes are read. The pins are sampled during the first byte
+ */
+bool HX711SimExpander::read(uint16_t &levels) {
+	uint8_t pin;
+
+	++_transactions;
+	transfer(2 * HX711SIMEXPANDER_FRAME + 3 * HX711SIMEXPANDER_BYTE);
+	levels = 0;
+	for (pin = 0; pin < 16; ++pin)
+		if ((_outputs >> pin) & 1)
+			levels |= _levels & (uint16_t(1) << pin);
+		else if (digitalRead(_base + pin))
+			levels |= uint16_t(1) << pin;
+	transfer(2 * HX711SIMEXPANDER_BYTE);
+	return true;
+}
+
+/*
+ * returns the amount of bus transactions
+ */
+uint32_t HX711SimExpander::getTransactions() {
+	return _transactions;
+}
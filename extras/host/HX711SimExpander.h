@@ -0,0 +1,52 @@
+#ifndef HX711SIMEXPANDER_H
+#define HX711SIMEXPANDER_H
+
+/*
+ * Simulated 16 bit I2C port expander with HX711SimChip chips on its
+ * pins, for HX711ExpanderBank on a host.
+ *
+ * Copyright (C) 2016 Edwin Croissant
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * See the README.md file for additional information.
+ */
+
+#include "HX711ExpanderBank.h"
+
+/*
+ * Expander pin n is pin base + n of the emulated board, put the
+ * HX711SimChip chips on those. Every transaction takes the time the
+ * bus would take at busHz, the same transactions as HX711MCP23017
+ */
+class HX711SimExpander: public HX711Expander {
+public:
+	HX711SimExpander(uint8_t base, uint32_t busHz);
+	bool setup(uint16_t outputs);
+	bool write(uint16_t levels);
+	uint16_t pulse(uint16_t pins, uint8_t count);
+	bool read(uint16_t &levels);
+	uint32_t getTransactions();
+
+private:
+	void transfer(uint16_t bits);
+	void set(uint16_t levels);
+	uint8_t _base;
+	uint32_t _busHz;
+	uint16_t _outputs;
+	uint16_t _levels;
+	uint32_t _transactions;
+};
+
+#endif //  HX711SIMEXPANDER_H
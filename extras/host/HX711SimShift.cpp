@@ -0,0 +1,119 @@
+#include <time.h>
+#include "Arduino.h"
+#include "HX711SimChip.h"
+#include "HX711SimShift.h"
+#include "SPI.h"
+
+SPIClass SPI;
+
+/*
+ * the chain on SPI
+ */
+static HX711SimShift *chain;
+
+static uint64_t nanos() {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return uint64_t(now.tv_sec) * 1000000000 + now.tv_nsec;
+}
+
+SPIClass::SPIClass() {
+	_clock = 4000000;
+	_mode = SPI_MODE0;
+}
+
+/*
+ * the bus starts in mode 0, SCK low
+ */
+void SPIClass::begin() {
+	_mode = SPI_MODE0;
+}
+
+/*
+ * mode 2 and 3 idle with SCK high, switching to them from
+ * mode 0 or 1 is a rising edge that shifts the chain
+ */
+void SPIClass::beginTransaction(SPISettings settings) {
+	_clock = settings.clock ? settings.clock : 4000000;
+	if ((settings.dataMode & 2) && !(_mode & 2) && chain)
+		chain->edge();
+	_mode = settings.dataMode;
+}
+
+/*
+ * shifts a byte out of the chain in the time the bus takes,
+ * MISO is high without a chain
+ */
+uint8_t SPIClass::transfer(uint8_t data) {
+	uint64_t until = nanos() + 8000000000ULL / _clock;
+
+	(void) data;
+	while (nanos() < until)
+		;
+	return chain ? chain->shift() : 0xFF;
+}
+
+void SPIClass::endTransaction() {
+}
+
+/*
+ * Makes a chain of (count + 7) / 8 registers on the pins
+ */
+
+HX711SimShift::HX711SimShift(uint8_t pinLoad, uint8_t firstPin,
+		uint8_t count) {
+	_pinLoad = pinLoad;
+	_firstPin = firstPin;
+	_count = count < 32 ? count : 32;
+	_register = 0;
+	_position = 0;
+	chain = this;
+	HX711SimChip::setPinHook(pinLoad, load, this);
+}
+
+HX711SimShift::~HX711SimShift() {
+	HX711SimChip::setPinHook(_pinLoad, NULL, NULL);
+	if (chain == this)
+		chain = NULL;
+}
+
+/*
+ * SH/LD going high loads the inputs, unused inputs are low
+ */
+void HX711SimShift::load(void *context, bool high) {
+	HX711SimShift *shift = (HX711SimShift *) context;
+	uint8_t pin;
+
+	if (!high)
+		return;
+	shift->_register = 0;
+	shift->_position = 0;
+	for (pin = 0; pin < shift->_count; ++pin)
+		if (digitalRead(shift->_firstPin + pin))
+			shift->_register |= uint32_t(1) << pin;
+}
+
+/*
+ * returns the next byte, QH of the nearest register first, the serial
+ * input of the last register is low
+ */
+uint8_t HX711SimShift::shift() {
+	uint8_t byte = 0, i;
+
+	for (i = 0; i < 8; ++i) {
+		byte <<= 1;
+		if (_position < 32)
+			byte |= (_register >> (_position / 8 * 8 + 7 - _position % 8)) & 1;
+		if (_position < 255)
+			++_position;
+	}
+	return byte;
+}
+
+/*
+ * one rising edge of SCK outside a transfer
+ */
+void HX711SimShift::edge() {
+	if (_position < 255)
+		++_position;
+}
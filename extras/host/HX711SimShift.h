@@ -0,0 +1,51 @@
+#ifndef HX711SIMSHIFT_H
+#define HX711SIMSHIFT_H
+
+/*
+ * Simulated chain of 74HC165 shift registers on the host SPI, for
+ * HX711ShiftBank with HX711SimChip chips.
+ *
+ * Copyright (C) 2016 Edwin Croissant
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * See the README.md file for additional information.
+ */
+
+#include <stdint.h>
+
+/*
+ * The registers load count consecutive pins of the emulated board from
+ * firstPin on the rising edge of pinLoad and SPI shifts them out, the
+ * first pin is input A of the register nearest to the board. There is
+ * one chain on SPI, every rising edge of SCK shifts it one bit, also the
+ * edge of switching SPI from an idle low clock to an idle high one
+ */
+class HX711SimShift {
+public:
+	HX711SimShift(uint8_t pinLoad, uint8_t firstPin, uint8_t count);
+	~HX711SimShift();
+	uint8_t shift();
+	void edge();
+
+private:
+	static void load(void *context, bool high);
+	uint8_t _pinLoad;
+	uint8_t _firstPin;
+	uint8_t _count;
+	uint32_t _register;
+	uint8_t _position;
+};
+
+#endif //  HX711SIMSHIFT_H
@@ -0,0 +1,101 @@
+/*
+ * Compares the kernels of HX711Transpose with a loop over every bit for
+ * turning the 24 bit planes of a bank read into readings, checks they
+ * give the same readings and reports the time per conversion.
+ *
+ * Build and run from this directory with:
+ *   g++ -O2 -I../../src HX711TransposeBench.cpp ../../src/HX711Transpose.cpp \
+ *       -o HX711TransposeBench
+ *   ./HX711TransposeBench 200000
+ * the argument is the amount of conversions per kernel and bank size.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "HX711Transpose.h"
+
+static const uint8_t counts[] = { 4, 8, 16, 24, 32 };
+
+static double seconds() {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+/*
+ * the way the banks did it, one bit at a time
+ */
+static void toRawBits(const uint32_t *planes, uint8_t count, int32_t *raw) {
+	uint8_t chip, bit;
+
+	for (chip = 0; chip < count; ++chip) {
+		uint32_t value = 0;
+		for (bit = 0; bit < 24; ++bit)
+			value = (value << 1) | ((planes[bit] >> chip) & 1);
+		raw[chip] = int32_t(value << 8);
+	}
+}
+
+/*
+ * returns ns per conversion, the planes change every time so the
+ * compiler can't hoist the conversion out of the loop
+ */
+static double measure(void (*kernel)(const uint32_t *, uint8_t, int32_t *),
+		uint32_t *planes, uint8_t count, uint32_t loops, int32_t &sum) {
+	int32_t raw[32];
+	double start = seconds();
+	uint32_t i;
+
+	for (i = 0; i < loops; ++i) {
+		planes[i % 24] += i;
+		kernel(planes, count, raw);
+		sum += raw[i % count];
+	}
+	return (seconds() - start) * 1e9 / loops;
+}
+
+int main(int argc, char *argv[]) {
+	uint32_t loops = argc > 1 ? strtoul(argv[1], NULL, 0) : 200000;
+	uint32_t planes[24], random = 1;
+	int32_t bits[32], eight[32], full[32], sum = 0;
+	uint8_t size, count, i, j;
+	int failures = 0;
+
+	if (!loops)
+		return 1;
+	/*
+	 * check the kernels on random planes first
+	 */
+	for (i = 0; i < 100; ++i) {
+		for (j = 0; j < 24; ++j) {
+			random = random * 1664525 + 1013904223;
+			planes[j] = random;
+		}
+		for (size = 0; size < sizeof(counts) / sizeof(counts[0]); ++size) {
+			count = counts[size];
+			toRawBits(planes, count, bits);
+			HX711Transpose::toRaw8(planes, count, eight);
+			HX711Transpose::toRaw32(planes, count, full);
+			for (j = 0; j < count; ++j)
+				if (eight[j] != bits[j] || full[j] != bits[j])
+					++failures;
+		}
+	}
+	printf("%s\n", failures ? "kernels WRONG" : "kernels agree");
+
+	printf("chips      bits    8 by 8  32 by 32 ns per conversion\n");
+	for (size = 0; size < sizeof(counts) / sizeof(counts[0]); ++size) {
+		count = counts[size];
+		printf("%5u %9.1f %9.1f %9.1f\n", count,
+				measure(toRawBits, planes, count, loops, sum),
+				measure(HX711Transpose::toRaw8, planes, count, loops, sum),
+				measure(HX711Transpose::toRaw32, planes, count, loops, sum));
+	}
+	/*
+	 * keeps the sum alive
+	 */
+	if (sum == 0x7FFFFFFF)
+		printf(" \n");
+	return failures ? 1 : 0;
+}
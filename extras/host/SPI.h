@@ -0,0 +1,61 @@
+#ifndef SPI_H
+#define SPI_H
+
+/*
+ * The part of the Arduino SPI API used by HX711ShiftBank, for building
+ * it on a host against HX711SimShift. Only for the host tools, never put
+ * this directory in the include path of a sketch.
+ *
+ * Copyright (C) 2016 Edwin Croissant
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * See the README.md file for additional information.
+ */
+
+#include "Arduino.h"
+
+#define SPI_MODE0 0
+#define SPI_MODE1 1
+#define SPI_MODE2 2
+#define SPI_MODE3 3
+
+class SPISettings {
+public:
+	SPISettings(uint32_t clock, uint8_t bitOrder, uint8_t dataMode) {
+		this->clock = clock;
+		this->bitOrder = bitOrder;
+		this->dataMode = dataMode;
+	}
+	uint32_t clock;
+	uint8_t bitOrder;
+	uint8_t dataMode;
+};
+
+class SPIClass {
+public:
+	SPIClass();
+	void begin();
+	void beginTransaction(SPISettings settings);
+	uint8_t transfer(uint8_t data);
+	void endTransaction();
+
+private:
+	uint32_t _clock;
+	uint8_t _mode;
+};
+
+extern SPIClass SPI;
+
+#endif //  SPI_H
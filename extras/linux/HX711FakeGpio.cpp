@@ -0,0 +1,168 @@
+#include <errno.h>
+#include <linux/gpio.h>
+#include <string.h>
+#include <time.h>
+#include "HX711FakeGpio.h"
+
+#define HX711FAKEGPIO_CHIP 1000
+#define HX711FAKEGPIO_LINES 1001
+
+static uint64_t nanos() {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return uint64_t(now.tv_sec) * 1000000000 + now.tv_nsec;
+}
+
+/*
+ * Makes a fake chip with an HX711 on every data line. A conversion is
+ * ready as soon as the previous one is read unless a conversion time is
+ * set, the values are set with setValue. Like a real HX711 the chips power down when the clock is
+ * high for more than 60 us.
+ */
+
+HX711FakeGpio::HX711FakeGpio(uint8_t chips) {
+	_chips = chips < HX711GPIOBANK_LINES ? chips : HX711GPIOBANK_LINES;
+	memset(_values, 0, sizeof(_values));
+	memset(_offsets, 0, sizeof(_offsets));
+	_lines = 0;
+	_clock = false;
+	_poweredDown = false;
+	_pulse = 0;
+	_pulses = 0;
+	_rising = 0;
+	_data = 0;
+	_conversionTime = 0;
+	_converted = 0;
+}
+
+int HX711FakeGpio::open(const char *name) {
+	(void) name;
+	return HX711FAKEGPIO_CHIP;
+}
+
+int HX711FakeGpio::close(int fd) {
+	(void) fd;
+	return 0;
+}
+
+/*
+ * sets the 24 bit value the chip converts next
+ */
+void HX711FakeGpio::setValue(uint8_t chip, int32_t value) {
+	if (chip < _chips)
+		_values[chip] = value;
+}
+
+/*
+ * returns the amount of clock pulses of the last read, 25 to 27
+ * select the gain
+ */
+uint8_t HX711FakeGpio::getPulses() {
+	return _pulses;
+}
+
+/*
+ * sets the time in ns between conversions, after a read the next
+ * conversion is ready at the next multiple of it, 0 makes it ready at once
+ */
+void HX711FakeGpio::setConversionTime(uint32_t conversionTime) {
+	_conversionTime = conversionTime;
+}
+
+/*
+ * returns true when the clock was high for too long
+ */
+bool HX711FakeGpio::isPoweredDown() {
+	return _poweredDown;
+}
+
+/*
+ * shifts out the next bit on a rising edge
+ */
+void HX711FakeGpio::clock(bool high) {
+	uint8_t chip;
+
+	if (high == _clock)
+		return;
+	_clock = high;
+	if (high) {
+		_rising = nanos();
+		if (_pulse < 24) {
+			_data = 0;
+			for (chip = 0; chip < _chips; ++chip)
+				_data |= uint64_t((_values[chip] >> (23 - _pulse)) & 1) << chip;
+		} else {
+			/*
+			 * busy with the next conversion
+			 */
+			_data = ~0ULL;
+		}
+		++_pulse;
+	} else {
+		if (nanos() - _rising > 60000) {
+			_poweredDown = true;
+			_pulse = 0;
+		} else
+			_poweredDown = false;
+		/*
+		 * the chip converts continuously, the next conversion is
+		 * ready at the next multiple of the conversion time
+		 */
+		if (_pulse >= 25 && _conversionTime)
+			_converted = nanos() / _conversionTime * _conversionTime
+					+ _conversionTime;
+	}
+}
+
+int HX711FakeGpio::ioctl(int fd, unsigned long request, void *argument) {
+	struct gpio_v2_line_request *lines;
+	struct gpio_v2_line_values *values;
+	uint32_t line;
+	uint64_t bits;
+
+	if (fd == HX711FAKEGPIO_CHIP && request == GPIO_V2_GET_LINE_IOCTL) {
+		lines = static_cast<struct gpio_v2_line_request*>(argument);
+		if (lines->num_lines < 2 || lines->num_lines > uint32_t(_chips) + 1) {
+			errno = EINVAL;
+			return -1;
+		}
+		_lines = lines->num_lines;
+		memcpy(_offsets, lines->offsets, _lines * sizeof(uint32_t));
+		lines->fd = HX711FAKEGPIO_LINES;
+		return 0;
+	}
+	if (fd != HX711FAKEGPIO_LINES) {
+		errno = EBADF;
+		return -1;
+	}
+	values = static_cast<struct gpio_v2_line_values*>(argument);
+	if (request == GPIO_V2_LINE_SET_VALUES_IOCTL) {
+		if (values->mask & 1)
+			clock(values->bits & 1);
+		return 0;
+	}
+	if (request == GPIO_V2_LINE_GET_VALUES_IOCTL) {
+		/*
+		 * with the clock low after a read the next conversion is ready
+		 */
+		if (!_clock && _pulse >= 25) {
+			_pulses = _pulse;
+			_pulse = 0;
+		}
+		if (_poweredDown)
+			bits = ~0ULL;
+		else if (!_clock && !_pulse)
+			bits = nanos() >= _converted ? 0 : ~0ULL;
+		else
+			bits = _data;
+		values->bits = 0;
+		for (line = 1; line < _lines; ++line)
+			if ((values->mask >> line) & 1)
+				values->bits |= ((bits >> (line - 1)) & 1) << line;
+		if ((values->mask & 1) && _clock)
+			values->bits |= 1;
+		return 0;
+	}
+	errno = EINVAL;
+	return -1;
+}
@@ -0,0 +1,55 @@
+#ifndef HX711FAKEGPIO_H
+#define HX711FAKEGPIO_H
+
+/*
+ * In process fake of the GPIO character device with HX711 chips
+ * for testing HX711GpioBank without hardware.
+ *
+ * Copyright (C) 2016 Edwin Croissant
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * See the README.md file for additional information.
+ */
+
+#include "HX711GpioBank.h"
+
+class HX711FakeGpio: public HX711GpioIo {
+public:
+	HX711FakeGpio(uint8_t chips);
+	int open(const char *name);
+	int ioctl(int fd, unsigned long request, void *argument);
+	int close(int fd);
+	void setValue(uint8_t chip, int32_t value);
+	uint8_t getPulses();
+	bool isPoweredDown();
+	void setConversionTime(uint32_t conversionTime);
+
+private:
+	void clock(bool high);
+	uint8_t _chips;
+	int32_t _values[HX711GPIOBANK_LINES];
+	uint32_t _offsets[HX711GPIOBANK_LINES + 1];
+	uint32_t _lines;
+	bool _clock;
+	bool _poweredDown;
+	uint8_t _pulse;
+	uint8_t _pulses;
+	uint64_t _rising;
+	uint64_t _data;
+	uint32_t _conversionTime;
+	uint64_t _converted;
+};
+
+#endif //  HX711FAKEGPIO_H
@@ -0,0 +1,314 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include "HX711Gateway.h"
+
+static uint64_t nanos() {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return uint64_t(now.tv_sec) * 1000000000 + now.tv_nsec;
+}
+
+/*
+ * returns the termios speed of the baud rate, B0 when not supported
+ */
+static speed_t speed(uint32_t baud) {
+	switch (baud) {
+	case 9600:
+		return B9600;
+	case 19200:
+		return B19200;
+	case 38400:
+		return B38400;
+	case 57600:
+		return B57600;
+	case 115200:
+		return B115200;
+	case 230400:
+		return B230400;
+	case 460800:
+		return B460800;
+	case 500000:
+		return B500000;
+	case 921600:
+		return B921600;
+	case 1000000:
+		return B1000000;
+	case 2000000:
+		return B2000000;
+	default:
+		return B0;
+	}
+}
+
+/*
+ * Makes a gateway that passes the samples of all streams to the sink.
+ * The nodes have their own millis() clock, the offset of every node to
+ * the host clock is tracked so the samples can be put in time order. A
+ * sample is held for window nanoseconds before it is passed on, so samples
+ * of slower streams can still be put before it. window is optional and
+ * defaults to 20 ms.
+ */
+
+HX711Gateway::HX711Gateway(HX711GatewaySink &sink, uint32_t window) :
+		_sink(sink) {
+	_window = window;
+	_epoll = -1;
+	_count = 0;
+	_order = 0;
+	_released = 0;
+	_reads = 0;
+	_late = 0;
+}
+
+HX711Gateway::~HX711Gateway() {
+	end();
+}
+
+/*
+ * makes the epoll instance, returns false on failure
+ */
+bool HX711Gateway::begin() {
+	end();
+	_epoll = epoll_create1(EPOLL_CLOEXEC);
+	return _epoll >= 0;
+}
+
+/*
+ * passes on the held samples and closes all devices
+ */
+void HX711Gateway::end() {
+	uint8_t i;
+
+	if (_epoll < 0)
+		return;
+	flush();
+	for (i = 0; i < _count; ++i)
+		remove(i);
+	close(_epoll);
+	_epoll = -1;
+	_count = 0;
+}
+
+/*
+ * opens a serial device in raw mode, for instance /dev/ttyUSB0 or the
+ * slave of a pseudo terminal. baud is optional and defaults to 115200.
+ * Returns the stream number or -1 on failure
+ */
+int HX711Gateway::add(const char *device, uint32_t baud) {
+	struct epoll_event event;
+	struct termios settings;
+	stream *added;
+	int fd;
+
+	if (_epoll < 0 || _count >= HX711GATEWAY_STREAMS || speed(baud) == B0)
+		return -1;
+	fd = open(device, O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+	if (fd < 0)
+		return -1;
+	if (tcgetattr(fd, &settings) < 0) {
+		close(fd);
+		return -1;
+	}
+	cfmakeraw(&settings);
+	cfsetspeed(&settings, speed(baud));
+	settings.c_cflag |= CLOCAL | CREAD;
+	if (tcsetattr(fd, TCSANOW, &settings) < 0) {
+		close(fd);
+		return -1;
+	}
+	event.events = EPOLLIN;
+	event.data.u32 = _count;
+	if (epoll_ctl(_epoll, EPOLL_CTL_ADD, fd, &event) < 0) {
+		close(fd);
+		return -1;
+	}
+	added = &_streams[_count];
+	added->fd = fd;
+	added->decoder = HX711FrameDecoder();
+	added->aligned = false;
+	added->offset = 0;
+	added->timestamp = 0;
+	added->wraps = 0;
+	return _count++;
+}
+
+/*
+ * closes the device of the stream, its counters are kept
+ */
+void HX711Gateway::remove(uint8_t stream) {
+	if (stream >= _count || _streams[stream].fd < 0)
+		return;
+	epoll_ctl(_epoll, EPOLL_CTL_DEL, _streams[stream].fd, NULL);
+	close(_streams[stream].fd);
+	_streams[stream].fd = -1;
+}
+
+/*
+ * waits at most timeout ms (-1 waits forever) for data, decodes it
+ * and passes on the samples older than the window. A device that hangs
+ * up is removed. Returns the amount of devices read or -1 on failure
+ */
+int HX711Gateway::poll(int timeout) {
+	struct epoll_event events[HX711GATEWAY_STREAMS];
+	uint64_t now;
+	int ready, i;
+
+	if (_epoll < 0)
+		return -1;
+	ready = epoll_wait(_epoll, events, HX711GATEWAY_STREAMS, timeout);
+	if (ready < 0)
+		return errno == EINTR ? 0 : -1;
+	now = nanos();
+	for (i = 0; i < ready; ++i) {
+		if (events[i].events & EPOLLIN)
+			receive(events[i].data.u32, now);
+		else
+			remove(events[i].data.u32);
+	}
+	release(nanos());
+	return ready;
+}
+
+/*
+ * passes on all held samples
+ */
+void HX711Gateway::flush() {
+	release(UINT64_MAX);
+}
+
+/*
+ * reads what the device has, one read per call so a busy device
+ * can't starve the others, and decodes the frames in it
+ */
+void HX711Gateway::receive(uint8_t index, uint64_t now) {
+	uint8_t buffer[HX711GATEWAY_BUFFER];
+	held sample;
+	stream &from = _streams[index];
+	ssize_t length;
+	size_t used = 0;
+	bool complete;
+
+	length = read(from.fd, buffer, sizeof(buffer));
+	if (length < 0 && (errno == EAGAIN || errno == EINTR))
+		return;
+	if (length <= 0) {
+		remove(index);
+		return;
+	}
+	++_reads;
+	while (used < size_t(length)) {
+		used += from.decoder.decode(buffer + used, length - used,
+				sample.sample.frame, complete);
+		if (complete) {
+			sample.sample.stream = index;
+			sample.order = _order++;
+			align(index, sample.sample, now);
+			_pending.push(sample);
+		}
+	}
+}
+
+/*
+ * converts the millis of the node to the host clock. The smallest
+ * difference between the arrival and the timestamp is the offset with
+ * the least delay on the link, the offset drops to every new minimum and
+ * creeps up by 1/64 of the difference otherwise so it follows a node
+ * clock that runs slow
+ */
+void HX711Gateway::align(uint8_t index, HX711GatewaySample &sample,
+		uint64_t now) {
+	stream &from = _streams[index];
+	uint64_t millis;
+	int64_t difference;
+
+	if (from.aligned && sample.frame.sample.timestamp < from.timestamp
+			&& from.timestamp - sample.frame.sample.timestamp > 0x80000000U)
+		from.wraps += 1ULL << 32;
+	from.timestamp = sample.frame.sample.timestamp;
+	millis = from.wraps + from.timestamp;
+	difference = int64_t(now) - int64_t(millis * 1000000);
+	if (!from.aligned || difference < from.offset)
+		from.offset = difference;
+	else
+		from.offset += (difference - from.offset) / 64;
+	from.aligned = true;
+	sample.time = millis * 1000000 + from.offset;
+}
+
+/*
+ * passes on the samples held for the window, in time order
+ */
+void HX711Gateway::release(uint64_t now) {
+	while (!_pending.empty()
+			&& (now == UINT64_MAX
+					|| _pending.top().sample.time + _window <= now)) {
+		if (_pending.top().sample.time < _released)
+			++_late;
+		else
+			_released = _pending.top().sample.time;
+		_sink.write(_pending.top().sample);
+		_pending.pop();
+	}
+}
+
+/*
+ * returns the amount of streams added
+ */
+uint8_t HX711Gateway::getStreams() {
+	return _count;
+}
+
+/*
+ * returns true when the device of the stream is open
+ */
+bool HX711Gateway::isOpen(uint8_t stream) {
+	return stream < _count && _streams[stream].fd >= 0;
+}
+
+/*
+ * returns the amount of valid frames of the stream
+ */
+uint32_t HX711Gateway::getFrames(uint8_t stream) {
+	return stream < _count ? _streams[stream].decoder.getFrames() : 0;
+}
+
+/*
+ * returns the amount of damaged frames of the stream
+ */
+uint32_t HX711Gateway::getErrors(uint8_t stream) {
+	return stream < _count ? _streams[stream].decoder.getErrors() : 0;
+}
+
+/*
+ * returns the amount of frames missing in the sequence of the stream
+ */
+uint32_t HX711Gateway::getLost(uint8_t stream) {
+	return stream < _count ? _streams[stream].decoder.getLost() : 0;
+}
+
+/*
+ * returns the host time minus the node time of the stream in ns
+ */
+int64_t HX711Gateway::getOffset(uint8_t stream) {
+	return stream < _count ? _streams[stream].offset : 0;
+}
+
+/*
+ * returns the amount of reads, divide the frames by it to get
+ * the frames per system call
+ */
+uint64_t HX711Gateway::getReads() {
+	return _reads;
+}
+
+/*
+ * returns the amount of samples passed on after a later sample of
+ * another stream, increase the window when this happens often
+ */
+uint64_t HX711Gateway::getLate() {
+	return _late;
+}
@@ -0,0 +1,112 @@
+#ifndef HX711GATEWAY_H
+#define HX711GATEWAY_H
+
+/*
+ * Gateway that reads the frames of many serial scale nodes with epoll
+ * and passes their samples in time order to one sink.
+ *
+ * Copyright (C) 2016 Edwin Croissant
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * See the README.md file for additional information.
+ */
+
+#include <functional>
+#include <queue>
+#include <stdint.h>
+#include <vector>
+#include "HX711Frame.h"
+
+/*
+ * the most serial devices and the bytes read from a device at once
+ */
+#define HX711GATEWAY_STREAMS 64
+#define HX711GATEWAY_BUFFER 4096
+
+/*
+ * a sample with the stream (the device) it came from and its time on
+ * the CLOCK_MONOTONIC of the host in nanoseconds
+ */
+struct HX711GatewaySample {
+	uint64_t time;
+	uint8_t stream;
+	HX711Frame frame;
+};
+
+/*
+ * where the samples go, in time order
+ */
+class HX711GatewaySink {
+public:
+	virtual ~HX711GatewaySink() {
+	}
+	virtual void write(const HX711GatewaySample &sample) = 0;
+};
+
+class HX711Gateway {
+public:
+	HX711Gateway(HX711GatewaySink &sink, uint32_t window = 20000000);
+	~HX711Gateway();
+	bool begin();
+	void end();
+	int add(const char *device, uint32_t baud = 115200);
+	void remove(uint8_t stream);
+	int poll(int timeout);
+	void flush();
+	uint8_t getStreams();
+	bool isOpen(uint8_t stream);
+	uint32_t getFrames(uint8_t stream);
+	uint32_t getErrors(uint8_t stream);
+	uint32_t getLost(uint8_t stream);
+	int64_t getOffset(uint8_t stream);
+	uint64_t getReads();
+	uint64_t getLate();
+
+private:
+	struct stream {
+		int fd;
+		HX711FrameDecoder decoder;
+		bool aligned;
+		int64_t offset;
+		uint32_t timestamp;
+		uint64_t wraps;
+	};
+	/*
+	 * samples with the same time stay in the order they arrived
+	 */
+	struct held {
+		HX711GatewaySample sample;
+		uint64_t order;
+		bool operator>(const held &other) const {
+			return sample.time > other.sample.time
+					|| (sample.time == other.sample.time && order > other.order);
+		}
+	};
+	void receive(uint8_t index, uint64_t now);
+	void align(uint8_t index, HX711GatewaySample &sample, uint64_t now);
+	void release(uint64_t now);
+	HX711GatewaySink &_sink;
+	uint32_t _window;
+	int _epoll;
+	stream _streams[HX711GATEWAY_STREAMS];
+	uint8_t _count;
+	std::priority_queue<held, std::vector<held>, std::greater<held> > _pending;
+	uint64_t _order;
+	uint64_t _released;
+	uint64_t _reads;
+	uint64_t _late;
+};
+
+#endif //  HX711GATEWAY_H
@@ -0,0 +1,162 @@
+/*
+ * Test and benchmark of HX711Gateway with pseudo terminals standing in
+ * for the serial nodes.
+ *
+ * Build and run from this directory with:
+ *   g++ -O2 -pthread -I../../src HX711GatewayBench.cpp HX711Gateway.cpp \
+ *       ../../src/HX711Frame.cpp -o HX711GatewayBench
+ *   ./HX711GatewayBench 32 20000 16
+ * the arguments are the amount of nodes, the frames per node and the
+ * frames per write. A writer thread starts every node with garbage, splits
+ * the frames at odd places and damages one frame of node 0, then checks
+ * every stream arrived complete and in order. The samples passed on out
+ * of time order across streams are reported as late.
+ */
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+#include "HX711Gateway.h"
+
+static uint64_t nanos() {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return uint64_t(now.tv_sec) * 1000000000 + now.tv_nsec;
+}
+
+class CheckSink: public HX711GatewaySink {
+public:
+	CheckSink(uint8_t nodes) :
+			counts(nodes), raws(nodes, -1) {
+	}
+	void write(const HX711GatewaySample &sample) {
+		if (sample.time < last)
+			++unordered;
+		last = sample.time;
+		/*
+		 * the raw reading counts the frames of the node
+		 */
+		if (sample.frame.node != sample.stream
+				|| sample.frame.sample.raw <= raws[sample.stream])
+			++wrong;
+		raws[sample.stream] = sample.frame.sample.raw;
+		++counts[sample.stream];
+		++total;
+	}
+	std::vector<uint32_t> counts;
+	std::vector<int32_t> raws;
+	uint64_t last = 0, unordered = 0, wrong = 0, total = 0;
+};
+
+/*
+ * writes the frames of all nodes, a chunk per node in turn,
+ * like nodes sending at the same rate
+ */
+static void writer(std::vector<int> &masters, uint32_t frames, uint32_t chunk) {
+	std::vector<HX711FrameEncoder> encoders;
+	std::vector<uint8_t> buffer;
+	uint8_t frame[HX711FRAME_SIZE], garbage[] = { 0x42, 0x17, 0xFF, 0x03 };
+	size_t node, offset;
+	uint32_t sent, i;
+	HX711Sample sample;
+
+	for (node = 0; node < masters.size(); ++node) {
+		encoders.push_back(HX711FrameEncoder(node));
+		if (write(masters[node], garbage, sizeof(garbage)) < 0)
+			return;
+	}
+	for (sent = 0; sent < frames; sent += chunk) {
+		for (node = 0; node < masters.size(); ++node) {
+			buffer.clear();
+			/*
+			 * a zero first, like a node that starts sending, the first
+			 * garbage is dropped without counting it as an error
+			 */
+			if (!sent)
+				buffer.push_back(0);
+			for (i = sent; i < sent + chunk && i < frames; ++i) {
+				/*
+				 * every node has its own clock, offset by a second
+				 */
+				sample.timestamp = nanos() / 1000000 + node * 1000;
+				sample.raw = i << 8;
+				uint8_t length = encoders[node].encode(sample, frame);
+				if (node == 0 && i == frames / 2)
+					frame[3] = frame[3] == 0x55 ? 0x56 : 0x55;
+				buffer.insert(buffer.end(), frame, frame + length);
+			}
+			/*
+			 * two writes split at an odd place
+			 */
+			offset = buffer.size() / 3;
+			if (write(masters[node], buffer.data(), offset) < 0
+					|| write(masters[node], buffer.data() + offset,
+							buffer.size() - offset) < 0)
+				return;
+		}
+	}
+}
+
+int main(int argc, char *argv[]) {
+	uint8_t nodes = argc > 1 ? atoi(argv[1]) : 32;
+	uint32_t frames = argc > 2 ? strtoul(argv[2], NULL, 0) : 20000;
+	uint32_t chunk = argc > 3 ? strtoul(argv[3], NULL, 0) : 16;
+	std::vector<int> masters;
+	CheckSink sink(nodes);
+	HX711Gateway gateway(sink, 5000000);
+	uint8_t node;
+	int failed = 0;
+
+	if (!nodes || nodes > HX711GATEWAY_STREAMS || !chunk || !gateway.begin())
+		return 1;
+	for (node = 0; node < nodes; ++node) {
+		int master = posix_openpt(O_RDWR | O_NOCTTY);
+		if (master < 0 || grantpt(master) < 0 || unlockpt(master) < 0
+				|| gateway.add(ptsname(master)) < 0) {
+			perror("pseudo terminal");
+			return 1;
+		}
+		masters.push_back(master);
+	}
+
+	uint64_t start = nanos();
+	std::thread thread(writer, std::ref(masters), frames, chunk);
+	uint64_t received = 0, target = uint64_t(nodes) * frames - 1;
+	while (received < target) {
+		if (gateway.poll(1000) <= 0)
+			break;
+		received = 0;
+		for (node = 0; node < nodes; ++node)
+			received += gateway.getFrames(node);
+	}
+	double seconds = (nanos() - start) / 1e9;
+	thread.join();
+	gateway.flush();
+
+	for (node = 0; node < nodes; ++node) {
+		uint32_t errors = node ? 0 : 1;
+		if (sink.counts[node] != frames - errors
+				|| gateway.getErrors(node) != errors
+				|| gateway.getLost(node) != errors) {
+			printf("node %u: %u frames, %u errors, %u lost\n", node,
+					sink.counts[node], gateway.getErrors(node),
+					gateway.getLost(node));
+			failed = 1;
+		}
+	}
+	printf("%u nodes, %llu samples in %.3f s, %.0f samples/s\n", nodes,
+			(unsigned long long) sink.total, seconds, sink.total / seconds);
+	printf("%llu reads, %.1f frames per read, %llu late, %llu out of order, "
+			"%llu wrong\n", (unsigned long long) gateway.getReads(),
+			double(sink.total) / gateway.getReads(),
+			(unsigned long long) gateway.getLate(),
+			(unsigned long long) sink.unordered,
+			(unsigned long long) sink.wrong);
+	for (node = 0; node < nodes; ++node)
+		close(masters[node]);
+	return failed || sink.wrong;
+}
@@ -0,0 +1,124 @@
+/*
+ * Gateway daemon for serial scale nodes that send HX711Frame frames,
+ * it publishes the samples of all nodes in time order on HX711SampleBus.
+ *
+ * Build from this directory with:
+ *   g++ -O2 -I../../src HX711GatewayDaemon.cpp HX711Gateway.cpp \
+ *       HX711SampleBus.cpp ../../src/HX711Frame.cpp -o HX711GatewayDaemon
+ * Usage:
+ *   HX711GatewayDaemon [-b baud] [-n bus] [-w window] [-p] device...
+ * bus defaults to /hx711gateway and window to 20 ms, -p prints the
+ * samples too. The record scale is the stream (the order of the devices),
+ * the sample timestamp is the host CLOCK_MONOTONIC in millis.
+ * SIGINT or SIGTERM stops it and prints the counters of every stream.
+ */
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include "HX711Gateway.h"
+#include "HX711SampleBus.h"
+
+static volatile sig_atomic_t running = 1;
+
+static void stop(int) {
+	running = 0;
+}
+
+class BusSink: public HX711GatewaySink {
+public:
+	BusSink(HX711BusPublisher &publisher, bool print) :
+			_publisher(publisher), _print(print) {
+	}
+	void write(const HX711GatewaySample &sample) {
+		HX711BusRecord record;
+		struct timespec now;
+
+		record.sample.timestamp = sample.time / 1000000;
+		record.sample.raw = sample.frame.sample.raw;
+		record.value = sample.frame.sample.raw / 256;
+		record.scale = sample.stream;
+		record.flags = 0;
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		record.nanos = uint64_t(now.tv_sec) * 1000000000 + now.tv_nsec;
+		_publisher.publish(record);
+		if (_print)
+			printf("%llu %u %u %u %ld\n", (unsigned long long) sample.time,
+					sample.stream, sample.frame.node, sample.frame.sequence,
+					(long) record.value);
+	}
+private:
+	HX711BusPublisher &_publisher;
+	bool _print;
+};
+
+int main(int argc, char *argv[]) {
+	const char *bus = "/hx711gateway";
+	uint32_t baud = 115200, window = 20;
+	bool print = false;
+	int option;
+
+	while ((option = getopt(argc, argv, "b:n:w:p")) != -1) {
+		switch (option) {
+		case 'b':
+			baud = strtoul(optarg, NULL, 0);
+			break;
+		case 'n':
+			bus = optarg;
+			break;
+		case 'w':
+			window = strtoul(optarg, NULL, 0);
+			break;
+		case 'p':
+			print = true;
+			break;
+		default:
+			optind = argc + 1;
+		}
+	}
+	if (optind >= argc) {
+		fprintf(stderr, "usage: %s [-b baud] [-n bus] [-w window] [-p] "
+				"device...\n", argv[0]);
+		return 1;
+	}
+
+	HX711BusPublisher publisher;
+	if (!publisher.begin(bus)) {
+		perror(bus);
+		return 1;
+	}
+	BusSink sink(publisher, print);
+	HX711Gateway gateway(sink, window * 1000000);
+	if (!gateway.begin()) {
+		perror("epoll");
+		return 1;
+	}
+	for (int i = optind; i < argc; ++i)
+		if (gateway.add(argv[i], baud) < 0) {
+			perror(argv[i]);
+			return 1;
+		}
+
+	signal(SIGINT, stop);
+	signal(SIGTERM, stop);
+	while (running)
+		if (gateway.poll(int(window)) < 0) {
+			perror("epoll");
+			break;
+		}
+	gateway.flush();
+
+	for (uint8_t stream = 0; stream < gateway.getStreams(); ++stream)
+		fprintf(stderr, "%s: %s, %u frames, %u errors, %u lost, "
+				"offset %lld ns\n", argv[optind + stream],
+				gateway.isOpen(stream) ? "open" : "closed",
+				gateway.getFrames(stream), gateway.getErrors(stream),
+				gateway.getLost(stream),
+				(long long) gateway.getOffset(stream));
+	fprintf(stderr, "%llu reads, %llu late\n",
+			(unsigned long long) gateway.getReads(),
+			(unsigned long long) gateway.getLate());
+	return 0;
+}
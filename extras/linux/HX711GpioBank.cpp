@@ -0,0 +1,272 @@
+#include <fcntl.h>
+#include <linux/gpio.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <time.h>
+#include <unistd.h>
+#include "HX711GpioBank.h"
+#include "HX711Transpose.h"
+
+/*
+ * the clock is the first line of the request, the data lines follow
+ */
+#define HX711GPIOBANK_CLOCK 1ULL
+
+/*
+ * PD_SCK high for longer than this powers the chip down
+ */
+#define HX711GPIOBANK_MAXHIGH 60000
+
+int HX711GpioIo::open(const char *name) {
+	return ::open(name, O_RDWR | O_CLOEXEC);
+}
+
+int HX711GpioIo::ioctl(int fd, unsigned long request, void *argument) {
+	return ::ioctl(fd, request, argument);
+}
+
+int HX711GpioIo::close(int fd) {
+	return ::close(fd);
+}
+
+static HX711GpioIo kernel;
+
+static uint64_t nanos() {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return uint64_t(now.tv_sec) * 1000000000 + now.tv_nsec;
+}
+
+/*
+ * Makes a bank of HX711 chips that share the clock line, every chip has
+ * its own data line. The io is optional and defaults to the kernel.
+ */
+
+HX711GpioBank::HX711GpioBank(HX711GpioIo &io) :
+		_io(io) {
+	_chip = -1;
+	_lines = -1;
+	_count = 0;
+	_gain = gain128;
+	_dataMask = 0;
+	_histogram = NULL;
+	memset(&_timing, 0, sizeof(_timing));
+}
+
+HX711GpioBank::HX711GpioBank() :
+		HX711GpioBank(kernel) {
+}
+
+HX711GpioBank::~HX711GpioBank() {
+	end();
+}
+
+/*
+ * requests the clock line as an output (low) and count data lines as
+ * inputs on the chip, for instance /dev/gpiochip0, as one line request
+ * so they are all accessed with one ioctl. Returns false on failure
+ */
+bool HX711GpioBank::begin(const char *chip, uint32_t clockLine,
+		const uint32_t *dataLines, uint8_t count, gain gain) {
+	struct gpio_v2_line_request request;
+	uint8_t i;
+
+	end();
+	if (!count || count > HX711GPIOBANK_LINES)
+		return false;
+	_chip = _io.open(chip);
+	if (_chip < 0)
+		return false;
+
+	memset(&request, 0, sizeof(request));
+	strncpy(request.consumer, "SimpleHX711", sizeof(request.consumer) - 1);
+	request.num_lines = count + 1;
+	request.offsets[0] = clockLine;
+	for (i = 0; i < count; ++i)
+		request.offsets[i + 1] = dataLines[i];
+	request.config.flags = GPIO_V2_LINE_FLAG_INPUT | GPIO_V2_LINE_FLAG_BIAS_PULL_UP;
+	request.config.num_attrs = 2;
+	request.config.attrs[0].attr.id = GPIO_V2_LINE_ATTR_ID_FLAGS;
+	request.config.attrs[0].attr.flags = GPIO_V2_LINE_FLAG_OUTPUT;
+	request.config.attrs[0].mask = HX711GPIOBANK_CLOCK;
+	request.config.attrs[1].attr.id = GPIO_V2_LINE_ATTR_ID_OUTPUT_VALUES;
+	request.config.attrs[1].attr.values = 0;
+	request.config.attrs[1].mask = HX711GPIOBANK_CLOCK;
+	if (_io.ioctl(_chip, GPIO_V2_GET_LINE_IOCTL, &request) < 0) {
+		end();
+		return false;
+	}
+	_lines = request.fd;
+	_count = count;
+	_gain = gain;
+	_dataMask = count == 63 ? ~HX711GPIOBANK_CLOCK :
+			((1ULL << count) - 1) << 1;
+	return true;
+}
+
+/*
+ * releases the lines and the chip
+ */
+void HX711GpioBank::end() {
+	if (_lines >= 0)
+		_io.close(_lines);
+	if (_chip >= 0)
+		_io.close(_chip);
+	_lines = -1;
+	_chip = -1;
+	_count = 0;
+}
+
+/*
+ * sets the clock line
+ */
+bool HX711GpioBank::setClock(bool high) {
+	struct gpio_v2_line_values values;
+
+	values.mask = HX711GPIOBANK_CLOCK;
+	values.bits = high ? HX711GPIOBANK_CLOCK : 0;
+	return _io.ioctl(_lines, GPIO_V2_LINE_SET_VALUES_IOCTL, &values) >= 0;
+}
+
+/*
+ * reads all data lines at once, bit 0 is the first data line
+ */
+bool HX711GpioBank::getData(uint64_t &bits) {
+	struct gpio_v2_line_values values;
+
+	values.mask = _dataMask;
+	values.bits = 0;
+	if (_io.ioctl(_lines, GPIO_V2_LINE_GET_VALUES_IOCTL, &values) < 0)
+		return false;
+	bits = (values.bits & _dataMask) >> 1;
+	return true;
+}
+
+/*
+ * returns a bit for every chip that has a conversion ready
+ * (its data line is low), bit 0 is the first data line
+ */
+uint64_t HX711GpioBank::getReady() {
+	uint64_t bits;
+
+	if (_lines < 0 || !getData(bits))
+		return 0;
+	return ~bits & (_dataMask >> 1);
+}
+
+/*
+ * returns true when all chips have a conversion ready
+ */
+bool HX711GpioBank::isReady() {
+	return _lines >= 0 && getReady() == (_dataMask >> 1);
+}
+
+/*
+ * reads all chips at once, raw must have room for a reading per chip.
+ * Like SimpleHX711 the 24 bits are in the most significant bits.
+ * Returns false when an ioctl fails or the clock was high for longer
+ * than 60 us, which may have powered the chips down
+ */
+bool HX711GpioBank::read(int32_t *raw) {
+	uint64_t planes[24], start, high, previous = 0, sumHigh = 0, sumPeriod = 0;
+	uint32_t half[24];
+	uint8_t bit, first, pulses, pulse;
+
+	if (_lines < 0)
+		return false;
+	memset(&_timing, 0, sizeof(_timing));
+	start = nanos();
+	pulses = _gain == gain128 ? 25 : (_gain == gain32 ? 26 : 27);
+	/*
+	 * the data is valid shortly after the rising edge so every bit takes
+	 * a rising edge, one read of all data lines and a falling edge
+	 */
+	for (pulse = 0; pulse < pulses; ++pulse) {
+		if (!setClock(true))
+			return false;
+		high = nanos();
+		if (pulse < 24 && !getData(planes[pulse])) {
+			setClock(false);
+			return false;
+		}
+		if (!setClock(false))
+			return false;
+		if (previous)
+			sumPeriod += high - previous;
+		previous = high;
+		high = nanos() - high;
+		sumHigh += high;
+		if (_histogram)
+			_histogram->add(high);
+		if (high > _timing.maxHigh)
+			_timing.maxHigh = high;
+		if (high > HX711GPIOBANK_MAXHIGH)
+			++_timing.overruns;
+	}
+	_timing.meanHigh = sumHigh / pulses;
+	_timing.meanPeriod = sumPeriod / (pulses - 1);
+	_timing.read = nanos() - start;
+
+	/*
+	 * every plane holds one bit of all chips, most significant bit
+	 * first, they are transposed 32 chips at a time
+	 */
+	for (first = 0; first < _count; first += 32) {
+		for (bit = 0; bit < 24; ++bit)
+			half[bit] = planes[bit] >> first;
+		HX711Transpose::toRaw(half, _count - first, raw + first);
+	}
+	return !_timing.overruns;
+}
+
+/*
+ * brings the chips in power down mode
+ */
+bool HX711GpioBank::powerDown() {
+	return _lines >= 0 && setClock(false) && setClock(true);
+}
+
+/*
+ * powerUp will reset the chips, the gain is 128 for the first conversion
+ */
+bool HX711GpioBank::powerUp() {
+	return _lines >= 0 && setClock(false);
+}
+
+/*
+ * possible values are gain128, gain64 (channel A) and gain32 (channel B)
+ * the new gain is selected by the next read and applies
+ * to the conversion after it
+ */
+void HX711GpioBank::setGain(gain gain) {
+	_gain = gain;
+}
+
+/*
+ * returns the gain
+ */
+HX711GpioBank::gain HX711GpioBank::getGain() {
+	return _gain;
+}
+
+/*
+ * returns the amount of chips
+ */
+uint8_t HX711GpioBank::getCount() {
+	return _count;
+}
+
+/*
+ * returns the clock timing of the last read
+ */
+HX711GpioTiming HX711GpioBank::getTiming() {
+	return _timing;
+}
+
+/*
+ * adds the high time of every clock pulse to the histogram,
+ * NULL stops it
+ */
+void HX711GpioBank::setHistogram(HX711Histogram *histogram) {
+	_histogram = histogram;
+}
@@ -0,0 +1,94 @@
+#ifndef HX711GPIOBANK_H
+#define HX711GPIOBANK_H
+
+/*
+ * Bank of HX711 chips on a Linux GPIO character device with a shared
+ * clock, read with the v2 uAPI.
+ *
+ * Copyright (C) 2016 Edwin Croissant
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * See the README.md file for additional information.
+ */
+
+#include <stdint.h>
+#include "HX711Histogram.h"
+
+/*
+ * the most data lines of a bank, one line of the request is the clock
+ */
+#define HX711GPIOBANK_LINES 63
+
+/*
+ * the calls to the kernel, replace them to test without hardware
+ */
+class HX711GpioIo {
+public:
+	virtual ~HX711GpioIo() {
+	}
+	virtual int open(const char *name);
+	virtual int ioctl(int fd, unsigned long request, void *argument);
+	virtual int close(int fd);
+};
+
+/*
+ * the clock timing of the last read in nanoseconds
+ */
+struct HX711GpioTiming {
+	uint32_t maxHigh;
+	uint32_t meanHigh;
+	uint32_t meanPeriod;
+	uint32_t read;
+	uint16_t overruns;
+};
+
+class HX711GpioBank {
+public:
+	enum gain {
+		gain32 = 32,
+		gain64 = 64,
+		gain128 = 128
+	};
+	HX711GpioBank(HX711GpioIo &io);
+	HX711GpioBank();
+	~HX711GpioBank();
+	bool begin(const char *chip, uint32_t clockLine, const uint32_t *dataLines,
+			uint8_t count, gain gain = gain128);
+	void end();
+	uint64_t getReady();
+	bool isReady();
+	bool read(int32_t *raw);
+	bool powerDown();
+	bool powerUp();
+	void setGain(gain gain);
+	gain getGain();
+	uint8_t getCount();
+	HX711GpioTiming getTiming();
+	void setHistogram(HX711Histogram *histogram);
+
+private:
+	bool setClock(bool high);
+	bool getData(uint64_t &bits);
+	HX711GpioIo &_io;
+	int _chip;
+	int _lines;
+	uint8_t _count;
+	gain _gain;
+	uint64_t _dataMask;
+	HX711GpioTiming _timing;
+	HX711Histogram *_histogram;
+};
+
+#endif //  HX711GPIOBANK_H
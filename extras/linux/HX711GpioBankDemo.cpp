@@ -0,0 +1,82 @@
+/*
+ * Reads a bank of HX711 chips with HX711GpioBank and reports the timing.
+ *
+ * Build from this directory with:
+ *   g++ -O2 -I../../src HX711GpioBankDemo.cpp HX711GpioBank.cpp \
+ *       HX711FakeGpio.cpp HX711Histogram.cpp ../../src/HX711Transpose.cpp \
+ *       -o HX711GpioBankDemo
+ * Usage:
+ *   HX711GpioBankDemo                              checks 16 fake chips
+ *   HX711GpioBankDemo /dev/gpiochip0 clock data... reads real chips or
+ *                                                  the gpio-sim driver
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "HX711FakeGpio.h"
+#include "HX711GpioBank.h"
+
+static void printTiming(HX711GpioBank &bank) {
+	HX711GpioTiming timing = bank.getTiming();
+	printf("read %u ns, clock high %u ns mean %u ns max, period %u ns, "
+			"%u overruns\n", timing.read, timing.meanHigh, timing.maxHigh,
+			timing.meanPeriod, timing.overruns);
+}
+
+static int fake() {
+	const uint8_t chips = 16;
+	HX711FakeGpio gpio(chips);
+	HX711GpioBank bank(gpio);
+	uint32_t data[chips];
+	int32_t raw[chips];
+	uint8_t chip, errors = 0;
+
+	for (chip = 0; chip < chips; ++chip) {
+		data[chip] = chip + 1;
+		gpio.setValue(chip, (chip & 1 ? -1 : 1) * 1000 * (chip + 1));
+	}
+	if (!bank.begin("fake", 0, data, chips, HX711GpioBank::gain64)
+			|| !bank.isReady() || !bank.read(raw))
+		return 1;
+	/*
+	 * the fake starts the next conversion when the data lines are read
+	 */
+	bank.getReady();
+	for (chip = 0; chip < chips; ++chip)
+		if (raw[chip] / 256 != (chip & 1 ? -1 : 1) * 1000 * (chip + 1))
+			++errors;
+	printf("%u chips, %u errors, %u clock pulses\n", chips, errors,
+			gpio.getPulses());
+	printTiming(bank);
+	return errors != 0;
+}
+
+int main(int argc, char *argv[]) {
+	if (argc < 2)
+		return fake();
+	if (argc < 4) {
+		fprintf(stderr, "usage: %s [chip clock data...]\n", argv[0]);
+		return 1;
+	}
+	HX711GpioBank bank;
+	uint32_t data[HX711GPIOBANK_LINES];
+	int32_t raw[HX711GPIOBANK_LINES];
+	uint8_t count = 0, i;
+	for (i = 3; i < argc && count < HX711GPIOBANK_LINES; ++i)
+		data[count++] = strtoul(argv[i], NULL, 0);
+	if (!bank.begin(argv[1], strtoul(argv[2], NULL, 0), data, count)) {
+		perror(argv[1]);
+		return 1;
+	}
+	for (;;) {
+		while (!bank.isReady())
+			usleep(1000);
+		if (!bank.read(raw))
+			printf("clock high for too long, ");
+		for (i = 0; i < count; ++i)
+			printf("%ld ", (long) raw[i] / 256);
+		printf("\n");
+		printTiming(bank);
+	}
+}
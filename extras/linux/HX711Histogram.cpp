@@ -0,0 +1,92 @@
+#include <string.h>
+#include "HX711Histogram.h"
+
+/*
+ * Makes a histogram with buckets of width, in nanoseconds for the
+ * latencies, width is optional and defaults to 1000
+ */
+
+HX711Histogram::HX711Histogram(uint32_t width) {
+	_width = width ? width : 1;
+	clear();
+}
+
+/*
+ * removes all values
+ */
+void HX711Histogram::clear() {
+	memset(_buckets, 0, sizeof(_buckets));
+	_overflow = 0;
+	_count = 0;
+	_max = 0;
+	_sum = 0;
+}
+
+/*
+ * adds a value, this does not allocate or lock so it can be
+ * called from a real time thread
+ */
+void HX711Histogram::add(uint64_t value) {
+	uint64_t bucket = value / _width;
+
+	if (bucket < HX711HISTOGRAM_BUCKETS)
+		++_buckets[bucket];
+	else
+		++_overflow;
+	++_count;
+	_sum += value;
+	if (value > _max)
+		_max = value;
+}
+
+/*
+ * returns the amount of values
+ */
+uint64_t HX711Histogram::getCount() {
+	return _count;
+}
+
+/*
+ * returns the largest value
+ */
+uint64_t HX711Histogram::getMax() {
+	return _max;
+}
+
+/*
+ * returns the amount of values beyond the last bucket
+ */
+uint64_t HX711Histogram::getOverflow() {
+	return _overflow;
+}
+
+/*
+ * returns the upper bound of the bucket that holds the percentile,
+ * the maximum when it lies in the overflow
+ */
+uint64_t HX711Histogram::getPercentile(double percentile) {
+	uint64_t target = uint64_t(percentile / 100 * _count + 0.5), sum = 0;
+	uint16_t bucket;
+
+	for (bucket = 0; bucket < HX711HISTOGRAM_BUCKETS; ++bucket) {
+		sum += _buckets[bucket];
+		if (sum >= target && sum)
+			return uint64_t(bucket + 1) * _width;
+	}
+	return _max;
+}
+
+/*
+ * prints a summary line
+ */
+void HX711Histogram::print(FILE *file, const char *name) {
+	fprintf(file, "%s: %llu values, mean %llu, p50 %llu, p99 %llu, "
+			"p99.9 %llu, max %llu, %llu beyond %llu\n", name,
+			(unsigned long long) _count,
+			(unsigned long long) (_count ? _sum / _count : 0),
+			(unsigned long long) getPercentile(50),
+			(unsigned long long) getPercentile(99),
+			(unsigned long long) getPercentile(99.9),
+			(unsigned long long) _max, (unsigned long long) _overflow,
+			(unsigned long long) _width * HX711HISTOGRAM_BUCKETS);
+}
@@ -0,0 +1,54 @@
+#ifndef HX711HISTOGRAM_H
+#define HX711HISTOGRAM_H
+
+/*
+ * Latency histogram for the Linux tools of the SimpleHX711 library.
+ *
+ * Copyright (C) 2016 Edwin Croissant
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * See the README.md file for additional information.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+
+/*
+ * the amount of buckets, values beyond the last bucket are counted
+ * as overflow
+ */
+#define HX711HISTOGRAM_BUCKETS 256
+
+class HX711Histogram {
+public:
+	HX711Histogram(uint32_t width = 1000);
+	void clear();
+	void add(uint64_t value);
+	uint64_t getCount();
+	uint64_t getMax();
+	uint64_t getOverflow();
+	uint64_t getPercentile(double percentile);
+	void print(FILE *file, const char *name);
+
+private:
+	uint32_t _width;
+	uint64_t _buckets[HX711HISTOGRAM_BUCKETS];
+	uint64_t _overflow;
+	uint64_t _count;
+	uint64_t _max;
+	uint64_t _sum;
+};
+
+#endif //  HX711HISTOGRAM_H
@@ -0,0 +1,71 @@
+/*
+ * Qualifies a Linux kernel for bit banging HX711 chips: runs
+ * HX711RtSampler and prints the latency histograms.
+ *
+ * Build from this directory with:
+ *   g++ -O2 -pthread -I../../src HX711RtQualify.cpp HX711RtSampler.cpp \
+ *       HX711GpioBank.cpp HX711FakeGpio.cpp HX711Histogram.cpp \
+ *       ../../src/HX711Transpose.cpp -o HX711RtQualify
+ * Usage:
+ *   HX711RtQualify seconds rate [cpu]                   with 4 fake chips
+ *   HX711RtQualify seconds rate cpu chip clock data...  with real chips
+ * Run it as root (or with CAP_SYS_NICE and CAP_IPC_LOCK) to get
+ * SCHED_FIFO and locked memory, and load the system meanwhile.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "HX711FakeGpio.h"
+#include "HX711RtSampler.h"
+
+int main(int argc, char *argv[]) {
+	if (argc < 3 || argc == 5 || argc == 6) {
+		fprintf(stderr, "usage: %s seconds rate [cpu [chip clock data...]]\n",
+				argv[0]);
+		return 1;
+	}
+	unsigned seconds = strtoul(argv[1], NULL, 0);
+	uint32_t rate = strtoul(argv[2], NULL, 0);
+	HX711FakeGpio fake(4);
+	HX711GpioIo kernel;
+	HX711GpioBank bank(argc > 4 ? kernel : static_cast<HX711GpioIo&>(fake));
+	uint32_t data[HX711GPIOBANK_LINES] = { 1, 2, 3, 4 };
+	uint8_t count = 4;
+	const char *chip = "fake";
+
+	if (argc > 4) {
+		chip = argv[4];
+		for (count = 0; count + 6 < argc && count < HX711GPIOBANK_LINES;
+				++count)
+			data[count] = strtoul(argv[count + 6], NULL, 0);
+	}
+	fake.setConversionTime(1000000000 / (rate ? rate : 10));
+	if (!bank.begin(chip, argc > 4 ? strtoul(argv[5], NULL, 0) : 0, data,
+			count)) {
+		perror(chip);
+		return 1;
+	}
+
+	HX711RtSampler sampler(bank, rate);
+	if (argc > 3)
+		sampler.setCpu(atoi(argv[3]));
+	if (!sampler.start()) {
+		perror("sampler");
+		return 1;
+	}
+	printf("SCHED_FIFO %s, memory %slocked\n",
+			sampler.isRealTime() ? "on" : "off (not permitted)",
+			sampler.isLocked() ? "" : "not ");
+	sleep(seconds);
+	sampler.stop();
+
+	printf("%llu samples, %llu with a clock pulse over 60 us, %llu missed\n",
+			(unsigned long long) sampler.getSamples(),
+			(unsigned long long) sampler.getOverruns(),
+			(unsigned long long) sampler.getMissed());
+	sampler.getPulseHistogram().print(stdout, "clock high ns");
+	sampler.getPickupHistogram().print(stdout, "pickup ns");
+	sampler.getPeriodHistogram().print(stdout, "period ns");
+	return sampler.getOverruns() || sampler.getMissed();
+}
@@ -0,0 +1,277 @@
+#include <sched.h>
+#include <sys/mman.h>
+#include <time.h>
+#include "HX711RtSampler.h"
+
+/*
+ * wake up this long before the conversion is expected and busy wait
+ * for the data lines from there
+ */
+#define HX711RTSAMPLER_MARGIN 2000000
+
+static uint64_t nanos() {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return uint64_t(now.tv_sec) * 1000000000 + now.tv_nsec;
+}
+
+/*
+ * Makes a sampler that reads the bank from its own thread. With
+ * SCHED_FIFO, a fixed cpu and locked memory nothing preempts the
+ * clock pulses, so they stay well below the 60 us that powers the
+ * chips down. The thread sleeps until shortly before the next conversion
+ * and then busy waits for it. dataRate is optional and defaults to 10 Hz.
+ * The clock pulse widths, the pickup delays (the time from the last
+ * poll that found the data not ready to the read) and the sample periods
+ * are recorded in histograms.
+ */
+
+HX711RtSampler::HX711RtSampler(HX711GpioBank &bank, uint32_t dataRate) :
+		_bank(bank), _pulses(1000), _pickups(1000), _periods(1000000) {
+	_period = 1000000000ULL / (dataRate ? dataRate : 10);
+	_priority = 80;
+	_cpu = -1;
+	_lockMemory = true;
+	_callback = NULL;
+	_context = NULL;
+	_running = false;
+	_started = false;
+	_realTime = false;
+	_locked = false;
+	_samples = 0;
+	_overruns = 0;
+	_missed = 0;
+}
+
+HX711RtSampler::~HX711RtSampler() {
+	stop();
+}
+
+/*
+ * sets the SCHED_FIFO priority, 0 runs the thread with the normal scheduler
+ */
+void HX711RtSampler::setPriority(int priority) {
+	_priority = priority;
+}
+
+/*
+ * pins the thread to a cpu, -1 lets it run anywhere
+ */
+void HX711RtSampler::setCpu(int cpu) {
+	_cpu = cpu;
+}
+
+/*
+ * locks all memory of the process so page faults can't stall the thread
+ */
+void HX711RtSampler::setLockMemory(bool lockMemory) {
+	_lockMemory = lockMemory;
+}
+
+/*
+ * sets the function called for every read, it runs in the real time
+ * thread so it must not block
+ */
+void HX711RtSampler::setCallback(HX711RtCallback callback, void *context) {
+	_callback = callback;
+	_context = context;
+}
+
+/*
+ * starts the thread, when real time scheduling or locking is not permitted
+ * the thread runs without it, check isRealTime and isLocked
+ * returns false when the thread can't be started
+ */
+bool HX711RtSampler::start() {
+	pthread_attr_t attributes;
+	struct sched_param parameters;
+	cpu_set_t cpus;
+
+	if (_started)
+		return true;
+	_locked = _lockMemory && !mlockall(MCL_CURRENT | MCL_FUTURE);
+	_samples = 0;
+	_overruns = 0;
+	_missed = 0;
+	_pulses.clear();
+	_pickups.clear();
+	_periods.clear();
+	_bank.setHistogram(&_pulses);
+	_running = true;
+
+	pthread_attr_init(&attributes);
+	if (_cpu >= 0) {
+		CPU_ZERO(&cpus);
+		CPU_SET(_cpu, &cpus);
+		pthread_attr_setaffinity_np(&attributes, sizeof(cpus), &cpus);
+	}
+	_realTime = false;
+	if (_priority > 0) {
+		parameters.sched_priority = _priority;
+		pthread_attr_setinheritsched(&attributes, PTHREAD_EXPLICIT_SCHED);
+		pthread_attr_setschedpolicy(&attributes, SCHED_FIFO);
+		pthread_attr_setschedparam(&attributes, &parameters);
+		_realTime = !pthread_create(&_thread, &attributes, thread, this);
+	}
+	if (!_realTime) {
+		/*
+		 * not permitted, try again with the normal scheduler
+		 */
+		pthread_attr_setinheritsched(&attributes, PTHREAD_INHERIT_SCHED);
+		if (pthread_create(&_thread, &attributes, thread, this)) {
+			pthread_attr_destroy(&attributes);
+			_running = false;
+			_bank.setHistogram(NULL);
+			return false;
+		}
+	}
+	pthread_attr_destroy(&attributes);
+	_started = true;
+	return true;
+}
+
+/*
+ * stops the thread and waits for it
+ */
+void HX711RtSampler::stop() {
+	if (!_started)
+		return;
+	_running = false;
+	pthread_join(_thread, NULL);
+	_bank.setHistogram(NULL);
+	if (_locked)
+		munlockall();
+	_started = false;
+}
+
+void *HX711RtSampler::thread(void *sampler) {
+	static_cast<HX711RtSampler*>(sampler)->run();
+	return NULL;
+}
+
+void HX711RtSampler::run() {
+	int32_t raw[HX711GPIOBANK_LINES];
+	uint64_t previous = 0, expected, now, polled, notReady;
+	struct timespec wake;
+	bool valid;
+
+	while (_running) {
+		/*
+		 * sleep until just before the next conversion is expected
+		 */
+		if (previous) {
+			expected = previous + _period;
+			if (expected > HX711RTSAMPLER_MARGIN + nanos()) {
+				expected -= HX711RTSAMPLER_MARGIN;
+				wake.tv_sec = expected / 1000000000;
+				wake.tv_nsec = expected % 1000000000;
+				clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake, NULL);
+			}
+		}
+		notReady = 0;
+		while (_running) {
+			polled = nanos();
+			if (_bank.isReady())
+				break;
+			notReady = polled;
+			/*
+			 * give up the cpu when the chips are disconnected
+			 */
+			if (previous && polled - previous > 4 * _period) {
+				wake.tv_sec = 0;
+				wake.tv_nsec = 1000000;
+				clock_nanosleep(CLOCK_MONOTONIC, 0, &wake, NULL);
+			}
+		}
+		if (!_running)
+			break;
+		now = nanos();
+		/*
+		 * when the data was ready at the first poll the thread woke up
+		 * late, count the delay from the expected conversion
+		 */
+		if (notReady)
+			_pickups.add(now - notReady);
+		else if (previous)
+			_pickups.add(now > previous + _period ? now - previous - _period : 0);
+		valid = _bank.read(raw);
+		if (!valid)
+			++_overruns;
+		if (previous) {
+			_periods.add(now - previous);
+			/*
+			 * a period of more than one and a half conversions
+			 * means a conversion was missed
+			 */
+			if (now - previous > _period + _period / 2)
+				_missed += (now - previous + _period / 2) / _period - 1;
+		}
+		previous = now;
+		++_samples;
+		/*
+		 * a failed read leaves raw stale or partial, it still
+		 * counts for the timing
+		 */
+		if (!valid)
+			continue;
+		if (_callback)
+			_callback(raw, _bank.getCount(), now, _context);
+	}
+}
+
+/*
+ * returns true when the thread runs with SCHED_FIFO
+ */
+bool HX711RtSampler::isRealTime() {
+	return _realTime;
+}
+
+/*
+ * returns true when the memory is locked
+ */
+bool HX711RtSampler::isLocked() {
+	return _locked;
+}
+
+/*
+ * returns the amount of reads
+ */
+uint64_t HX711RtSampler::getSamples() {
+	return _samples.load();
+}
+
+/*
+ * returns the amount of reads with a clock pulse longer than 60 us
+ */
+uint64_t HX711RtSampler::getOverruns() {
+	return _overruns.load();
+}
+
+/*
+ * returns the amount of conversions that were not read in time
+ */
+uint64_t HX711RtSampler::getMissed() {
+	return _missed.load();
+}
+
+/*
+ * returns the histogram of the clock high times in ns,
+ * only read it after stop
+ */
+HX711Histogram &HX711RtSampler::getPulseHistogram() {
+	return _pulses;
+}
+
+/*
+ * returns the histogram of the pickup delays in ns
+ */
+HX711Histogram &HX711RtSampler::getPickupHistogram() {
+	return _pickups;
+}
+
+/*
+ * returns the histogram of the sample periods in ns, 1 ms buckets
+ */
+HX711Histogram &HX711RtSampler::getPeriodHistogram() {
+	return _periods;
+}
@@ -0,0 +1,80 @@
+#ifndef HX711RTSAMPLER_H
+#define HX711RTSAMPLER_H
+
+/*
+ * Real time sampling thread for a HX711GpioBank on Linux.
+ *
+ * Copyright (C) 2016 Edwin Croissant
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * See the README.md file for additional information.
+ */
+
+#include <atomic>
+#include <pthread.h>
+#include <stdint.h>
+#include "HX711GpioBank.h"
+#include "HX711Histogram.h"
+
+/*
+ * called from the sampling thread for every successful read, timestamp is the
+ * CLOCK_MONOTONIC time in nanoseconds at which the data was found ready
+ */
+typedef void (*HX711RtCallback)(const int32_t *raw, uint8_t count,
+		uint64_t timestamp, void *context);
+
+class HX711RtSampler {
+public:
+	HX711RtSampler(HX711GpioBank &bank, uint32_t dataRate = 10);
+	~HX711RtSampler();
+	void setPriority(int priority);
+	void setCpu(int cpu);
+	void setLockMemory(bool lockMemory);
+	void setCallback(HX711RtCallback callback, void *context);
+	bool start();
+	void stop();
+	bool isRealTime();
+	bool isLocked();
+	uint64_t getSamples();
+	uint64_t getOverruns();
+	uint64_t getMissed();
+	HX711Histogram &getPulseHistogram();
+	HX711Histogram &getPickupHistogram();
+	HX711Histogram &getPeriodHistogram();
+
+private:
+	static void *thread(void *sampler);
+	void run();
+	HX711GpioBank &_bank;
+	uint64_t _period;
+	int _priority;
+	int _cpu;
+	bool _lockMemory;
+	HX711RtCallback _callback;
+	void *_context;
+	pthread_t _thread;
+	std::atomic<bool> _running;
+	bool _started;
+	bool _realTime;
+	bool _locked;
+	std::atomic<uint64_t> _samples;
+	std::atomic<uint64_t> _overruns;
+	std::atomic<uint64_t> _missed;
+	HX711Histogram _pulses;
+	HX711Histogram _pickups;
+	HX711Histogram _periods;
+};
+
+#endif //  HX711RTSAMPLER_H
@@ -0,0 +1,323 @@
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#include "HX711SampleBus.h"
+
+/*
+ * every slot starts on its own cache line so a subscriber reading a slot
+ * doesn't share it with the slot the publisher writes
+ */
+#define HX711SAMPLEBUS_SLOT ((sizeof(HX711BusSlot) + 63) & ~size_t(63))
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+		"the sequence numbers must be lock free to be shared between processes");
+
+static HX711BusSlot *slotAt(void *base, uint64_t index) {
+	return reinterpret_cast<HX711BusSlot*>(static_cast<uint8_t*>(base)
+			+ sizeof(HX711BusHeader) + index * HX711SAMPLEBUS_SLOT);
+}
+
+static long futex(const std::atomic<uint32_t> *address, int operation,
+		uint32_t value, const struct timespec *timeout) {
+	return syscall(SYS_futex, address, operation, value, timeout, NULL, 0);
+}
+
+/*
+ * Makes a publisher, call begin to create the shared memory
+ */
+
+HX711BusPublisher::HX711BusPublisher() {
+	_name[0] = 0;
+	_header = NULL;
+	_slots = NULL;
+	_size = 0;
+	_mask = 0;
+	_head = 0;
+}
+
+HX711BusPublisher::~HX711BusPublisher() {
+	end();
+}
+
+/*
+ * creates the shared memory object /name, for instance "/scale", with
+ * room for capacity records, capacity is rounded up to a power of two.
+ * An existing object is replaced, subscribers of it must begin again.
+ * Returns false on failure
+ */
+bool HX711BusPublisher::begin(const char *name, uint32_t capacity) {
+	void *base;
+	int fd;
+	uint64_t i;
+
+	end();
+	if (strlen(name) >= sizeof(_name) || capacity < 2 || capacity > 1U << 30)
+		return false;
+	_mask = 1;
+	while (_mask < capacity)
+		_mask <<= 1;
+	_size = sizeof(HX711BusHeader) + _mask * HX711SAMPLEBUS_SLOT;
+	--_mask;
+
+	/*
+	 * subscribers check the magic, so a new object is made rather than
+	 * changing one they may have mapped
+	 */
+	shm_unlink(name);
+	fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0644);
+	if (fd < 0)
+		return false;
+	if (ftruncate(fd, _size) < 0) {
+		close(fd);
+		shm_unlink(name);
+		return false;
+	}
+	base = mmap(NULL, _size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (base == MAP_FAILED) {
+		shm_unlink(name);
+		return false;
+	}
+	strcpy(_name, name);
+	_header = static_cast<HX711BusHeader*>(base);
+	_slots = slotAt(base, 0);
+	_header->capacity = _mask + 1;
+	_header->recordSize = sizeof(HX711BusRecord);
+	_header->slotSize = HX711SAMPLEBUS_SLOT;
+	_header->head.store(0, std::memory_order_relaxed);
+	_header->futex.store(0, std::memory_order_relaxed);
+	_header->waiters.store(0, std::memory_order_relaxed);
+	for (i = 0; i <= _mask; ++i)
+		slotAt(base, i)->sequence.store(0, std::memory_order_relaxed);
+	_head = 0;
+	_header->magic.store(HX711SAMPLEBUS_MAGIC, std::memory_order_release);
+	return true;
+}
+
+/*
+ * unmaps the shared memory, unlink is optional and defaults to true,
+ * which removes the object once all subscribers have ended
+ */
+void HX711BusPublisher::end(bool unlink) {
+	if (!_header)
+		return;
+	munmap(_header, _size);
+	if (unlink)
+		shm_unlink(_name);
+	_header = NULL;
+	_slots = NULL;
+	_name[0] = 0;
+}
+
+/*
+ * writes the record in the next slot, the oldest record is overwritten
+ * when the ring is full. This never blocks on the subscribers, only
+ * one thread may publish
+ */
+void HX711BusPublisher::publish(const HX711BusRecord &record) {
+	HX711BusSlot *slot;
+
+	if (!_header)
+		return;
+	slot = slotAt(_header, _head & _mask);
+	/*
+	 * a seqlock: the odd sequence tells subscribers the record is being
+	 * written, the fence keeps the record writes after it
+	 */
+	slot->sequence.store(_head * 2 + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	slot->record = record;
+	slot->sequence.store(_head * 2 + 2, std::memory_order_release);
+	_header->head.store(++_head, std::memory_order_release);
+
+	/*
+	 * the fence orders the head before the waiter count, wait does the
+	 * reverse, so either the waiter sees the head or it is woken
+	 */
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (_header->waiters.load(std::memory_order_relaxed)) {
+		_header->futex.fetch_add(1, std::memory_order_seq_cst);
+		futex(&_header->futex, FUTEX_WAKE, INT32_MAX, NULL);
+	}
+}
+
+/*
+ * returns the amount of records published
+ */
+uint64_t HX711BusPublisher::getHead() {
+	return _head;
+}
+
+/*
+ * Makes a subscriber, call begin to map the shared memory
+ */
+
+HX711BusSubscriber::HX711BusSubscriber() {
+	_header = NULL;
+	_slots = NULL;
+	_size = 0;
+	_mask = 0;
+	_next = 0;
+	_lost = 0;
+}
+
+HX711BusSubscriber::~HX711BusSubscriber() {
+	end();
+}
+
+/*
+ * maps the shared memory object made by a publisher. latest is optional
+ * and defaults to true to start with the next record published, false
+ * starts with the oldest record still in the ring.
+ * Returns false when there is no publisher or the layout doesn't match
+ */
+bool HX711BusSubscriber::begin(const char *name, bool latest) {
+	struct stat status;
+	void *base;
+	int fd;
+	uint64_t head;
+
+	end();
+	/*
+	 * mapped writable for the waiter count, the slots are only read
+	 */
+	fd = shm_open(name, O_RDWR, 0);
+	if (fd < 0)
+		return false;
+	if (fstat(fd, &status) < 0 || size_t(status.st_size) < sizeof(HX711BusHeader)) {
+		close(fd);
+		return false;
+	}
+	base = mmap(NULL, status.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (base == MAP_FAILED)
+		return false;
+	_header = static_cast<const HX711BusHeader*>(base);
+	_size = status.st_size;
+	if (_header->magic.load(std::memory_order_acquire) != HX711SAMPLEBUS_MAGIC
+			|| _header->recordSize != sizeof(HX711BusRecord)
+			|| _header->slotSize != HX711SAMPLEBUS_SLOT
+			|| (_header->capacity & (_header->capacity - 1))
+			|| _size < sizeof(HX711BusHeader)
+					+ size_t(_header->capacity) * HX711SAMPLEBUS_SLOT) {
+		end();
+		return false;
+	}
+	_slots = slotAt(base, 0);
+	_mask = _header->capacity - 1;
+	head = _header->head.load(std::memory_order_acquire);
+	if (latest)
+		_next = head;
+	else
+		_next = head > _mask ? head - _mask : 0;
+	_lost = 0;
+	return true;
+}
+
+/*
+ * unmaps the shared memory
+ */
+void HX711BusSubscriber::end() {
+	if (!_header)
+		return;
+	munmap(const_cast<HX711BusHeader*>(_header), _size);
+	_header = NULL;
+	_slots = NULL;
+}
+
+/*
+ * copies the next record. Returns empty when no new record is published
+ * and overrun when the publisher overwrote records this subscriber
+ * didn't read yet, it then skips to the oldest records that are safe
+ * to read and adds the skipped records to the lost count
+ */
+HX711BusSubscriber::status HX711BusSubscriber::read(HX711BusRecord &record) {
+	const HX711BusSlot *slot;
+	uint64_t expected, sequence, head;
+
+	if (!_header)
+		return empty;
+	slot = slotAt(const_cast<HX711BusHeader*>(_header), _next & _mask);
+	expected = _next * 2 + 2;
+	sequence = slot->sequence.load(std::memory_order_acquire);
+	if (sequence == expected) {
+		record = slot->record;
+		/*
+		 * the record is valid when the publisher didn't start on the slot
+		 * while it was copied
+		 */
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (slot->sequence.load(std::memory_order_relaxed) == expected) {
+			++_next;
+			return ok;
+		}
+	} else if (sequence < expected)
+		return empty;
+
+	/*
+	 * the slot holds a later record, skip ahead leaving half the ring
+	 * as headroom so the publisher doesn't overtake again right away
+	 */
+	head = _header->head.load(std::memory_order_acquire);
+	_lost += head - (_mask + 1) / 2 - _next;
+	_next = head - (_mask + 1) / 2;
+	return overrun;
+}
+
+/*
+ * waits until a record is published after the last one read or
+ * timeout microseconds pass. Returns true when a record is available
+ */
+bool HX711BusSubscriber::wait(uint32_t timeout) {
+	HX711BusHeader *header = const_cast<HX711BusHeader*>(_header);
+	struct timespec duration;
+	uint32_t value;
+
+	if (!header)
+		return false;
+	if (header->head.load(std::memory_order_acquire) > _next)
+		return true;
+	duration.tv_sec = timeout / 1000000;
+	duration.tv_nsec = (timeout % 1000000) * 1000;
+	header->waiters.fetch_add(1, std::memory_order_seq_cst);
+	value = header->futex.load(std::memory_order_seq_cst);
+	/*
+	 * the head is checked again after registering so a record published
+	 * in between is not slept through, the futex value catches the rest
+	 */
+	if (header->head.load(std::memory_order_seq_cst) <= _next)
+		futex(&header->futex, FUTEX_WAIT, value, &duration);
+	header->waiters.fetch_sub(1, std::memory_order_seq_cst);
+	return header->head.load(std::memory_order_acquire) > _next;
+}
+
+/*
+ * returns the sequence number of the next record to read
+ */
+uint64_t HX711BusSubscriber::getNext() {
+	return _next;
+}
+
+/*
+ * returns the amount of published records not read yet
+ */
+uint64_t HX711BusSubscriber::getBehind() {
+	uint64_t head;
+
+	if (!_header)
+		return 0;
+	head = _header->head.load(std::memory_order_acquire);
+	return head > _next ? head - _next : 0;
+}
+
+/*
+ * returns the amount of records skipped by overruns
+ */
+uint64_t HX711BusSubscriber::getLost() {
+	return _lost;
+}
@@ -0,0 +1,122 @@
+#ifndef HX711SAMPLEBUS_H
+#define HX711SAMPLEBUS_H
+
+/*
+ * Lock-free ring of samples in POSIX shared memory with one publisher
+ * and any number of subscribers.
+ *
+ * Copyright (C) 2016 Edwin Croissant
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * See the README.md file for additional information.
+ */
+
+#include <atomic>
+#include <stdint.h>
+#include "HX711Sample.h"
+
+/*
+ * identifies the layout of the shared memory, change it with the layout
+ */
+#define HX711SAMPLEBUS_MAGIC 0x31425348U
+
+/*
+ * the default amount of records in the ring, must be a power of two
+ */
+#ifndef HX711SAMPLEBUS_CAPACITY
+#define HX711SAMPLEBUS_CAPACITY 4096
+#endif
+
+/*
+ * a sample as published on the bus. nanos is CLOCK_MONOTONIC at
+ * publishing so subscribers can measure the latency
+ */
+struct HX711BusRecord {
+	HX711Sample sample;
+	int32_t value;
+	uint16_t scale;
+	uint16_t flags;
+	uint64_t nanos;
+};
+
+/*
+ * a record with its sequence number, the sequence is odd while the
+ * publisher writes the record and twice the record number plus 2 after
+ */
+struct HX711BusSlot {
+	std::atomic<uint64_t> sequence;
+	HX711BusRecord record;
+};
+
+/*
+ * the start of the shared memory, the slots follow it. The head is the
+ * amount of records published, it has its own cache line so polling
+ * subscribers don't slow down the publisher
+ */
+struct HX711BusHeader {
+	std::atomic<uint32_t> magic;
+	uint32_t capacity;
+	uint32_t recordSize;
+	uint32_t slotSize;
+	alignas(64) std::atomic<uint64_t> head;
+	alignas(64) std::atomic<uint32_t> futex;
+	std::atomic<uint32_t> waiters;
+};
+
+class HX711BusPublisher {
+public:
+	HX711BusPublisher();
+	~HX711BusPublisher();
+	bool begin(const char *name, uint32_t capacity = HX711SAMPLEBUS_CAPACITY);
+	void end(bool unlink = true);
+	void publish(const HX711BusRecord &record);
+	uint64_t getHead();
+
+private:
+	char _name[64];
+	HX711BusHeader *_header;
+	HX711BusSlot *_slots;
+	size_t _size;
+	uint32_t _mask;
+	uint64_t _head;
+};
+
+class HX711BusSubscriber {
+public:
+	enum status {
+		ok,
+		empty,
+		overrun
+	};
+	HX711BusSubscriber();
+	~HX711BusSubscriber();
+	bool begin(const char *name, bool latest = true);
+	void end();
+	status read(HX711BusRecord &record);
+	bool wait(uint32_t timeout);
+	uint64_t getNext();
+	uint64_t getBehind();
+	uint64_t getLost();
+
+private:
+	const HX711BusHeader *_header;
+	const HX711BusSlot *_slots;
+	size_t _size;
+	uint32_t _mask;
+	uint64_t _next;
+	uint64_t _lost;
+};
+
+#endif //  HX711SAMPLEBUS_H
@@ -0,0 +1,127 @@
+/*
+ * Throughput and latency of HX711SampleBus with many subscriber processes.
+ *
+ * Build and run from this directory with:
+ *   g++ -O2 -I../../src HX711SampleBusBench.cpp HX711SampleBus.cpp \
+ *       HX711Histogram.cpp -o HX711SampleBusBench
+ *   ./HX711SampleBusBench 4 1000000 0 wait
+ * the arguments are the amount of subscribers, the amount of records,
+ * the publishing rate in Hz (0 publishes as fast as possible) and
+ * wait or poll. Subscribers that poll yield the cpu when the ring is empty.
+ */
+
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+#include "HX711Histogram.h"
+#include "HX711SampleBus.h"
+
+static uint64_t nanos() {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return uint64_t(now.tv_sec) * 1000000000 + now.tv_nsec;
+}
+
+/*
+ * reads all records, checks they arrive in order and prints the latency
+ */
+static int subscribe(int index, uint64_t records, bool wait, int ready) {
+	HX711BusSubscriber subscriber;
+	HX711BusRecord record;
+	HX711Histogram latency(wait ? 1000 : 100);
+	uint64_t received = 0, overruns = 0, errors = 0, expected = 0;
+
+	if (!subscriber.begin("/hx711bench", false)) {
+		perror("subscriber");
+		return 1;
+	}
+	if (write(ready, "", 1) != 1)
+		return 1;
+	close(ready);
+	while (subscriber.getNext() < records) {
+		switch (subscriber.read(record)) {
+		case HX711BusSubscriber::ok:
+			latency.add(nanos() - record.nanos);
+			if (uint64_t(record.sample.timestamp) != (expected & 0xFFFFFFFF))
+				++errors;
+			expected = subscriber.getNext();
+			++received;
+			break;
+		case HX711BusSubscriber::overrun:
+			expected = subscriber.getNext();
+			++overruns;
+			break;
+		case HX711BusSubscriber::empty:
+			if (wait)
+				subscriber.wait(100000);
+			else
+				sched_yield();
+			break;
+		}
+	}
+	printf("subscriber %d: %llu received, %llu lost in %llu overruns, "
+			"%llu out of order\n", index, (unsigned long long) received,
+			(unsigned long long) subscriber.getLost(),
+			(unsigned long long) overruns, (unsigned long long) errors);
+	char name[48];
+	snprintf(name, sizeof(name), "subscriber %d latency ns", index);
+	latency.print(stdout, name);
+	fflush(stdout);
+	return errors != 0;
+}
+
+int main(int argc, char *argv[]) {
+	int subscribers = argc > 1 ? atoi(argv[1]) : 4;
+	uint64_t records = argc > 2 ? strtoull(argv[2], NULL, 0) : 1000000;
+	uint32_t rate = argc > 3 ? strtoul(argv[3], NULL, 0) : 0;
+	bool waiting = argc <= 4 || strcmp(argv[4], "poll");
+	HX711BusPublisher publisher;
+	HX711BusRecord record;
+	int ready[2], i, status, failed = 0;
+	char byte;
+
+	if (!publisher.begin("/hx711bench") || pipe(ready) < 0) {
+		perror("publisher");
+		return 1;
+	}
+	for (i = 0; i < subscribers; ++i) {
+		if (!fork()) {
+			close(ready[0]);
+			return subscribe(i, records, waiting, ready[1]);
+		}
+	}
+	close(ready[1]);
+	for (i = 0; i < subscribers; ++i)
+		if (::read(ready[0], &byte, 1) != 1)
+			return 1;
+
+	memset(&record, 0, sizeof(record));
+	uint64_t start = nanos(), next = start;
+	for (uint64_t sequence = 0; sequence < records; ++sequence) {
+		if (rate) {
+			next += 1000000000 / rate;
+			struct timespec wake = { time_t(next / 1000000000),
+					long(next % 1000000000) };
+			clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake, NULL);
+		}
+		record.sample.timestamp = sequence;
+		record.sample.raw = int32_t(sequence * 2654435761u) >> 8 << 8;
+		record.value = record.sample.raw >> 8;
+		record.nanos = nanos();
+		publisher.publish(record);
+	}
+	double seconds = (nanos() - start) / 1e9;
+	printf("published %llu records in %.3f s, %.0f records/s\n",
+			(unsigned long long) records, seconds, records / seconds);
+	fflush(stdout);
+
+	while (wait(&status) > 0)
+		if (!WIFEXITED(status) || WEXITSTATUS(status))
+			failed = 1;
+	publisher.end();
+	return failed;
+}
@@ -0,0 +1,194 @@
+#include "HX711Canceller.h"
+
+/*
+ * Makes an adaptive noise canceller. Accelerations of the platform
+ * show up in the readings as a disturbance correlated with an
+ * accelerometer on the platform. A normalized LMS filter learns that
+ * correlation and subtracts the estimated disturbance from every reading.
+ * mu is the optional step size and defaults to 4096, an input of 32768
+ * gives mu = 32768 / 65536 = 0.5, a larger mu adapts faster but
+ * leaves more noise.
+ * offset is the optional time in millis added to the timestamp of the
+ * reading to align it with the reference, it defaults to 0
+ */
+
+HX711Canceller::HX711Canceller(uint16_t mu, int16_t offset) {
+	_mu = mu;
+	_offset = offset;
+	_adapt = true;
+	reset();
+}
+
+/*
+ * forget the references and the learned filter
+ */
+void HX711Canceller::reset() {
+	uint8_t i;
+	for (i = 0; i < HX711CANCELLER_REFERENCES; ++i) {
+		_references[i] = 0;
+		_timestamps[i] = 0;
+	}
+	for (i = 0; i < HX711CANCELLER_TAPS; ++i) {
+		_taps[i] = 0;
+		_weights[i] = 0;
+	}
+	_head = 0;
+	_referenceCount = 0;
+	_mean = 0;
+	_valueMean = 0;
+	_valueStarted = false;
+	_disturbance = 0;
+}
+
+/*
+ * adds a reading of the accelerometer, the timestamp is in millis
+ * and must use the same clock as the scale
+ */
+void HX711Canceller::addReference(int16_t reference, uint32_t timestamp) {
+	_head = (_head + 1) % HX711CANCELLER_REFERENCES;
+	_references[_head] = reference;
+	_timestamps[_head] = timestamp;
+	/*
+	 * the gravity in the reference does not change with the platform
+	 * movement so track the mean (times 256) to remove it, the time
+	 * constant is long as any ripple on the mean ends up in the output
+	 */
+	if (_referenceCount < HX711CANCELLER_REFERENCES) {
+		if (!_referenceCount)
+			_mean = int32_t(reference) << 8;
+		++_referenceCount;
+	}
+	_mean += ((int32_t(reference) << 8) - _mean) / 4096;
+}
+
+/*
+ * returns the reference minus its mean at the timestamp, interpolated
+ * between the buffered references
+ */
+int16_t HX711Canceller::referenceAt(uint32_t timestamp) {
+	uint8_t i, newer, older;
+	int32_t reference, span;
+
+	if (!_referenceCount)
+		return 0;
+	newer = _head;
+	reference = _references[newer];
+	if (int32_t(timestamp - _timestamps[newer]) < 0) {
+		for (i = 1; i < _referenceCount; ++i) {
+			older = (newer + HX711CANCELLER_REFERENCES - 1)
+					% HX711CANCELLER_REFERENCES;
+			reference = _references[older];
+			if (int32_t(timestamp - _timestamps[older]) >= 0) {
+				span = _timestamps[newer] - _timestamps[older];
+				if (span)
+					reference += (int32_t(_references[newer]) - reference)
+							* int32_t(timestamp - _timestamps[older]) / span;
+				break;
+			}
+			newer = older;
+		}
+	}
+	reference -= (_mean + 128) >> 8;
+	return constrain(reference, -32768, 32767);
+}
+
+/*
+ * removes the disturbance from the reading and adapts the filter,
+ * the timestamp is in millis as returned by SimpleHX711::getTimestamp()
+ * returns the cleaned reading
+ */
+int32_t HX711Canceller::cancel(int32_t value, uint32_t timestamp) {
+	uint8_t i;
+	int64_t estimate = 0, power = 16 * HX711CANCELLER_TAPS, step;
+	int32_t error;
+
+	for (i = HX711CANCELLER_TAPS - 1; i > 0; --i)
+		_taps[i] = _taps[i - 1];
+	_taps[0] = referenceAt(timestamp + _offset);
+
+	for (i = 0; i < HX711CANCELLER_TAPS; ++i) {
+		estimate += int64_t(_weights[i]) * _taps[i];
+		power += int32_t(_taps[i]) * _taps[i];
+	}
+	/*
+	 * the weights are fixed point with 16 fractional bits
+	 */
+	_disturbance = (estimate + 32768) >> 16;
+	error = value - _disturbance;
+
+	/*
+	 * the weight on the scale does not correlate with the reference
+	 * but it does add noise to the adaption so adapt on the
+	 * error minus the mean of the readings
+	 */
+	if (!_valueStarted) {
+		_valueMean = value;
+		_valueStarted = true;
+	}
+	_valueMean += (value - _valueMean) / 1024;
+
+	if (_adapt) {
+		error -= _valueMean;
+		/*
+		 * limit the error so a load change can't overflow the update,
+		 * the << 16 and >> 16 keep the precision of the division
+		 */
+		step = (int64_t(constrain(error, -8388608L, 8388607L)) * _mu << 16)
+				/ power;
+		for (i = 0; i < HX711CANCELLER_TAPS; ++i)
+			_weights[i] += (step * _taps[i]) >> 16;
+	}
+	return value - _disturbance;
+}
+
+/*
+ * returns the disturbance removed from the last reading
+ */
+int32_t HX711Canceller::getDisturbance() {
+	return _disturbance;
+}
+
+/*
+ * sets the step size of the adaption, an input of 32768
+ * gives mu = 32768 / 65536 = 0.5
+ */
+void HX711Canceller::setMu(uint16_t mu) {
+	_mu = mu;
+}
+
+/*
+ * returns the step size
+ */
+uint16_t HX711Canceller::getMu() {
+	return _mu;
+}
+
+/*
+ * sets the time in millis added to the timestamp of the reading
+ * to find the matching reference
+ */
+void HX711Canceller::setOffset(int16_t offset) {
+	_offset = offset;
+}
+
+/*
+ * returns the offset
+ */
+int16_t HX711Canceller::getOffset() {
+	return _offset;
+}
+
+/*
+ * when adapt is false the filter is frozen, for instance
+ * during a load change
+ */
+void HX711Canceller::setAdapt(bool adapt) {
+	_adapt = adapt;
+}
+
+/*
+ * returns true when the filter adapts
+ */
+bool HX711Canceller::getAdapt() {
+	return _adapt;
+}
@@ -0,0 +1,66 @@
+#ifndef HX711CANCELLER_H
+#define HX711CANCELLER_H
+
+/*
+ * Adaptive vibration cancellation with an accelerometer reference
+ * for the SimpleHX711 library.
+ *
+ * Copyright (C) 2016 Edwin Croissant
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * See the README.md file for additional information.
+ */
+
+#include "Arduino.h"
+
+/*
+ * the amount of filter taps and the amount of buffered reference readings,
+ * they size the class so they are the same for the library and every sketch
+ */
+#define HX711CANCELLER_TAPS 4
+#define HX711CANCELLER_REFERENCES 8
+
+class HX711Canceller {
+public:
+	HX711Canceller(uint16_t mu = 4096, int16_t offset = 0);
+	void reset();
+	void addReference(int16_t reference, uint32_t timestamp);
+	int32_t cancel(int32_t value, uint32_t timestamp);
+	int32_t getDisturbance();
+	void setMu(uint16_t mu);
+	uint16_t getMu();
+	void setOffset(int16_t offset);
+	int16_t getOffset();
+	void setAdapt(bool adapt);
+	bool getAdapt();
+
+private:
+	int16_t referenceAt(uint32_t timestamp);
+	uint16_t _mu;
+	int16_t _offset;
+	bool _adapt;
+	int16_t _references[HX711CANCELLER_REFERENCES];
+	uint32_t _timestamps[HX711CANCELLER_REFERENCES];
+	uint8_t _head;
+	uint8_t _referenceCount;
+	int32_t _mean;
+	int32_t _valueMean;
+	bool _valueStarted;
+	int16_t _taps[HX711CANCELLER_TAPS];
+	int32_t _weights[HX711CANCELLER_TAPS];
+	int32_t _disturbance;
+};
+
+#endif //  HX711CANCELLER_H
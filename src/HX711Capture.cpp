@@ -0,0 +1,213 @@
+#include "HX711Capture.h"
+
+/*
+ * Makes a capture buffer in the style of an oscilloscope. Once armed it
+ * records every sample in a circular buffer, when a trigger fires it
+ * records the post trigger samples and freezes, leaving preTrigger
+ * samples before and size - preTrigger samples from the trigger on.
+ * The buffer is supplied by the caller so nothing is allocated, feed it
+ * from read() with SimpleHX711::setOnRead.
+ */
+
+HX711Capture::HX711Capture(HX711Sample *buffer, uint16_t size,
+		uint16_t preTrigger) {
+	_buffer = buffer;
+	_size = size;
+	_preTrigger = preTrigger < size ? preTrigger : size - 1;
+	_threshold = false;
+	_rising = true;
+	_level = 0;
+	_slope = 0;
+	disarm();
+}
+
+/*
+ * clears the buffer and starts recording, waiting for a trigger
+ */
+void HX711Capture::arm() {
+	_head = 0;
+	_count = 0;
+	_triggerIndex = 0;
+	_state = armed;
+}
+
+/*
+ * stops recording
+ */
+void HX711Capture::disarm() {
+	_head = 0;
+	_count = 0;
+	_triggerIndex = 0;
+	_state = idle;
+}
+
+/*
+ * records a sample and checks the triggers, the timestamp is
+ * in millis as returned by SimpleHX711::getTimestamp()
+ */
+void HX711Capture::add(int32_t raw, uint32_t timestamp) {
+	bool fire = false;
+
+	if (_state == idle || _state == frozen)
+		return;
+
+	if (_state == armed && _count) {
+		if (_threshold)
+			fire = _rising ?
+					(_last < _level && raw >= _level) :
+					(_last > _level && raw <= _level);
+		if (_slope)
+			fire |= (raw - _last) >= _slope || (_last - raw) >= _slope;
+	}
+	_last = raw;
+
+	_buffer[_head].timestamp = timestamp;
+	_buffer[_head].raw = raw;
+	_head = (_head + 1) % _size;
+	if (_count < _size)
+		++_count;
+
+	if (_state == triggered) {
+		if (!--_remaining)
+			freeze();
+	} else if (fire) {
+		/*
+		 * the sample that fired the trigger is the first
+		 * post trigger sample
+		 */
+		_state = triggered;
+		_remaining = _size - _preTrigger - 1;
+		if (!_remaining)
+			freeze();
+	}
+}
+
+/*
+ * fires the trigger, the next sample is the first post trigger sample
+ */
+void HX711Capture::trigger() {
+	if (_state != armed)
+		return;
+	_state = triggered;
+	_remaining = _size - _preTrigger;
+}
+
+/*
+ * stops recording and marks the trigger position
+ */
+void HX711Capture::freeze() {
+	_triggerIndex = _count - (_size - _preTrigger);
+	_state = frozen;
+}
+
+/*
+ * returns the state of the capture
+ * idle : not recording
+ * armed : recording and waiting for a trigger
+ * triggered : recording the post trigger samples
+ * frozen : the capture is complete
+ */
+HX711Capture::state HX711Capture::getState() {
+	return _state;
+}
+
+/*
+ * fires the trigger when the sample crosses the level, upwards
+ * when rising is true, downwards when false. rising is optional
+ * and defaults to true
+ */
+void HX711Capture::setThreshold(int32_t level, bool rising) {
+	_threshold = true;
+	_level = level;
+	_rising = rising;
+}
+
+/*
+ * disables the threshold trigger
+ */
+void HX711Capture::clearThreshold() {
+	_threshold = false;
+}
+
+/*
+ * fires the trigger when two consecutive samples differ by slope
+ * or more, 0 disables the slope trigger
+ */
+void HX711Capture::setSlope(int32_t slope) {
+	_slope = slope;
+}
+
+/*
+ * returns the slope
+ */
+int32_t HX711Capture::getSlope() {
+	return _slope;
+}
+
+/*
+ * sets the amount of samples kept before the trigger, this
+ * also clears the buffer
+ */
+void HX711Capture::setPreTrigger(uint16_t preTrigger) {
+	_preTrigger = preTrigger < _size ? preTrigger : _size - 1;
+	if (_state != idle)
+		arm();
+}
+
+/*
+ * returns the amount of samples kept before the trigger
+ */
+uint16_t HX711Capture::getPreTrigger() {
+	return _preTrigger;
+}
+
+/*
+ * returns the amount of recorded samples
+ */
+uint16_t HX711Capture::getCount() {
+	return _count;
+}
+
+/*
+ * returns the index of the first post trigger sample in a frozen capture
+ */
+uint16_t HX711Capture::getTriggerIndex() {
+	return _triggerIndex;
+}
+
+/*
+ * returns a recorded sample, index 0 is the oldest
+ */
+HX711Sample HX711Capture::getSample(uint16_t index) {
+	return _buffer[(_head + _size - _count + index) % _size];
+}
+
+/*
+ * writes the capture in binary form: the amount of samples and the
+ * trigger index as uint16_t followed by the samples, oldest first,
+ * all in the byte order of the microcontroller
+ * returns the amount of bytes written
+ */
+size_t HX711Capture::dump(Print &out) {
+	size_t written;
+	uint16_t i, first, part;
+
+	written = out.write(reinterpret_cast<const uint8_t*>(&_count),
+			sizeof(_count));
+	written += out.write(reinterpret_cast<const uint8_t*>(&_triggerIndex),
+			sizeof(_triggerIndex));
+	/*
+	 * the samples wrap around the end of the buffer so write
+	 * them in at most two parts
+	 */
+	first = (_head + _size - _count) % _size;
+	for (i = 0; i < _count; i += part) {
+		part = _count - i;
+		if (part > _size - first)
+			part = _size - first;
+		written += out.write(reinterpret_cast<const uint8_t*>(&_buffer[first]),
+				part * sizeof(HX711Sample));
+		first = 0;
+	}
+	return written;
+}
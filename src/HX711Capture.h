@@ -0,0 +1,67 @@
+#ifndef HX711CAPTURE_H
+#define HX711CAPTURE_H
+
+/*
+ * Pre and post trigger capture buffer for the SimpleHX711 library.
+ *
+ * Copyright (C) 2016 Edwin Croissant
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * See the README.md file for additional information.
+ */
+
+#include "Arduino.h"
+#include "SimpleHX711.h"
+
+class HX711Capture {
+public:
+	enum state {
+		idle, armed, triggered, frozen
+	};
+	HX711Capture(HX711Sample *buffer, uint16_t size, uint16_t preTrigger);
+	void arm();
+	void disarm();
+	void add(int32_t raw, uint32_t timestamp);
+	void trigger();
+	state getState();
+	void setThreshold(int32_t level, bool rising = true);
+	void clearThreshold();
+	void setSlope(int32_t slope);
+	int32_t getSlope();
+	void setPreTrigger(uint16_t preTrigger);
+	uint16_t getPreTrigger();
+	uint16_t getCount();
+	uint16_t getTriggerIndex();
+	HX711Sample getSample(uint16_t index);
+	size_t dump(Print &out);
+
+private:
+	void freeze();
+	HX711Sample *_buffer;
+	uint16_t _size;
+	uint16_t _preTrigger;
+	uint16_t _head;
+	uint16_t _count;
+	uint16_t _remaining;
+	uint16_t _triggerIndex;
+	state _state;
+	bool _threshold;
+	bool _rising;
+	int32_t _level;
+	int32_t _slope;
+	int32_t _last;
+};
+
+#endif //  HX711CAPTURE_H
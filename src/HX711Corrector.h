@@ -0,0 +1,48 @@
+#ifndef HX711CORRECTOR_H
+#define HX711CORRECTOR_H
+
+/*
+ * Interface of a correction applied to every raw reading of SimpleHX711.
+ *
+ * Copyright (C) 2016 Edwin Croissant
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * See the README.md file for additional information.
+ */
+
+#include <stdint.h>
+
+/*
+ * SimpleHX711 only calls a corrector through this interface, so a sketch
+ * that never sets one doesn't link the correction, HX711Hysteresis is one
+ */
+class HX711Corrector {
+public:
+	/*
+	 * returns the corrected raw reading
+	 */
+	virtual int32_t correct(int32_t value) = 0;
+
+	/*
+	 * forgets the previous readings
+	 */
+	virtual void reset() = 0;
+
+protected:
+	~HX711Corrector() {
+	}
+};
+
+#endif //  HX711CORRECTOR_H
@@ -0,0 +1,161 @@
+#include "HX711ExpanderBank.h"
+#include "HX711Transpose.h"
+
+/*
+ * Makes a bank of HX711 chips on an expander. pinClk is the expander pin
+ * (0 to 15) of the shared clock, dataPins has a bit set for the expander
+ * pin of every data line. The gain is optional and defaults to gain128.
+ * Every clock pulse is one bus transaction and the data lines are read
+ * after it in one more, while the clock is low, so only the pulse itself
+ * counts towards the 60 us limit.
+ */
+
+HX711ExpanderBank::HX711ExpanderBank(HX711Expander &expander, uint8_t pinClk,
+		uint16_t dataPins, gain gain) :
+		_expander(expander) {
+	uint8_t pin;
+
+	_clock = uint16_t(1) << (pinClk & 15);
+	_dataPins = dataPins & ~_clock;
+	_count = 0;
+	for (pin = 0; pin < 16; ++pin)
+		if ((_dataPins >> pin) & 1)
+			++_count;
+	_gain = gain;
+	memset(&_timing, 0, sizeof(_timing));
+}
+
+/*
+ * sets up the expander, returns false when it does not respond or its
+ * clock pulses are too long, for instance with a 100 kHz bus
+ */
+bool HX711ExpanderBank::begin() {
+	if (!_expander.setup(_clock))
+		return false;
+	/*
+	 * a pulse on no pins measures the bus without clocking the chips
+	 */
+	return _expander.pulse(0, 1) <= HX711EXPANDERBANK_MAXHIGH;
+}
+
+/*
+ * returns a bit for every chip that has a conversion ready
+ * (its data line is low), bit 0 is the lowest data pin
+ */
+uint16_t HX711ExpanderBank::getReady() {
+	uint16_t levels, ready = 0;
+	uint8_t pin, chip = 0;
+
+	if (!_expander.read(levels))
+		return 0;
+	for (pin = 0; pin < 16; ++pin) {
+		if (!((_dataPins >> pin) & 1))
+			continue;
+		if (!((levels >> pin) & 1))
+			ready |= uint16_t(1) << chip;
+		++chip;
+	}
+	return ready;
+}
+
+/*
+ * returns true when all chips have a conversion ready
+ */
+bool HX711ExpanderBank::isReady() {
+	return _count && getReady() == uint16_t((uint32_t(1) << _count) - 1);
+}
+
+/*
+ * reads all chips at once, raw must have room for a reading per chip.
+ * Like SimpleHX711 the 24 bits are in the most significant bits.
+ * Returns false when the expander fails or a clock pulse took longer
+ * than 60 us, which may have powered the chips down
+ */
+bool HX711ExpanderBank::read(int32_t *raw) {
+	uint32_t planes[24], start;
+	int32_t pins[16];
+	uint16_t levels, high;
+	uint8_t bit, pin, chip;
+
+	memset(&_timing, 0, sizeof(_timing));
+	start = micros();
+	/*
+	 * the rising edge shifts out the next bit, it stays on the
+	 * data lines until the next rising edge
+	 */
+	for (bit = 0; bit < 24; ++bit) {
+		high = _expander.pulse(_clock, 1);
+		if (high > _timing.maxHigh)
+			_timing.maxHigh = high;
+		if (high > HX711EXPANDERBANK_MAXHIGH && _timing.overruns < 255)
+			++_timing.overruns;
+		if (!_expander.read(levels))
+			return false;
+		planes[bit] = levels;
+	}
+	/*
+	 * the pulses that select the gain fit in one transaction
+	 */
+	high = _expander.pulse(_clock,
+			_gain == gain128 ? 1 : (_gain == gain32 ? 2 : 3));
+	if (high > _timing.maxHigh)
+		_timing.maxHigh = high;
+	if (high > HX711EXPANDERBANK_MAXHIGH && _timing.overruns < 255)
+		++_timing.overruns;
+	_timing.read = micros() - start;
+
+	/*
+	 * every plane holds one bit of all pins, the readings of the
+	 * data pins are taken in order
+	 */
+	HX711Transpose::toRaw(planes, 16, pins);
+	chip = 0;
+	for (pin = 0; pin < 16; ++pin)
+		if ((_dataPins >> pin) & 1)
+			raw[chip++] = pins[pin];
+	return !_timing.overruns;
+}
+
+/*
+ * brings the chips in power down mode
+ */
+bool HX711ExpanderBank::powerDown() {
+	return _expander.write(0) && _expander.write(_clock);
+}
+
+/*
+ * powerUp will reset the chips, the gain is 128 for the first conversion
+ */
+bool HX711ExpanderBank::powerUp() {
+	return _expander.write(0);
+}
+
+/*
+ * possible values are gain128, gain64 (channel A) and gain32 (channel B)
+ * the new gain is selected by the next read and applies
+ * to the conversion after it
+ */
+void HX711ExpanderBank::setGain(gain gain) {
+	_gain = gain;
+}
+
+/*
+ * returns the gain
+ */
+HX711ExpanderBank::gain HX711ExpanderBank::getGain() {
+	return _gain;
+}
+
+/*
+ * returns the amount of chips
+ */
+uint8_t HX711ExpanderBank::getCount() {
+	return _count;
+}
+
+/*
+ * returns the timing of the last read
+ */
+HX711ExpanderTiming HX711ExpanderBank::getTiming() {
+	return _timing;
+}
@@ -0,0 +1,87 @@
+#ifndef HX711EXPANDERBANK_H
+#define HX711EXPANDERBANK_H
+
+/*
+ * Bank of HX711 chips behind a 16 bit I2C port expander: the shared
+ * clock and all data lines are pins of the expander.
+ *
+ * Copyright (C) 2016 Edwin Croissant
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * See the README.md file for additional information.
+ */
+
+#include "Arduino.h"
+
+/*
+ * the clock must not be high for longer than 60 us or the chips power
+ * down, begin fails when the expander can't pulse faster than this
+ */
+#define HX711EXPANDERBANK_MAXHIGH 60
+
+/*
+ * a 16 bit port expander as used by the bank, pins that are not outputs
+ * are inputs with pull ups. Replace it to test without hardware
+ */
+class HX711Expander {
+public:
+	virtual ~HX711Expander() {
+	}
+	virtual bool setup(uint16_t outputs) = 0;
+	virtual bool write(uint16_t levels) = 0;
+	virtual uint16_t pulse(uint16_t pins, uint8_t count) = 0;
+	virtual bool read(uint16_t &levels) = 0;
+};
+
+/*
+ * the timing of the last read in us, maxHigh is the longest clock
+ * high time as estimated by the expander
+ */
+struct HX711ExpanderTiming {
+	uint16_t maxHigh;
+	uint32_t read;
+	uint8_t overruns;
+};
+
+class HX711ExpanderBank {
+public:
+	enum gain {
+		gain32 = 32,
+		gain64 = 64,
+		gain128 = 128
+	};
+	HX711ExpanderBank(HX711Expander &expander, uint8_t pinClk,
+			uint16_t dataPins, gain gain = gain128);
+	bool begin();
+	uint16_t getReady();
+	bool isReady();
+	bool read(int32_t *raw);
+	bool powerDown();
+	bool powerUp();
+	void setGain(gain gain);
+	gain getGain();
+	uint8_t getCount();
+	HX711ExpanderTiming getTiming();
+
+private:
+	HX711Expander &_expander;
+	uint16_t _clock;
+	uint16_t _dataPins;
+	uint8_t _count;
+	gain _gain;
+	HX711ExpanderTiming _timing;
+};
+
+#endif //  HX711EXPANDERBANK_H
@@ -0,0 +1,283 @@
+#ifndef HX711FIXED_H
+#define HX711FIXED_H
+
+/*
+ * Fixed point weight with saturating arithmetic, rounding and formatting.
+ *
+ * Copyright (C) 2016 Edwin Croissant
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * See the README.md file for additional information.
+ */
+
+#include <stdint.h>
+
+/*
+ * the most decimals format writes
+ */
+#define HX711FIXED_DECIMALS 4
+
+/*
+ * the buffer size format needs: a sign, 10 digits, a point,
+ * the decimals and the terminating zero
+ */
+#define HX711FIXED_TEXT (14 + HX711FIXED_DECIMALS)
+
+/*
+ * A value with Q (1 to 16) fractional bits in an int32_t, HX711Weight has
+ * 8 so it holds -8388608 to 8388607.996 in steps of 1/256. Arithmetic
+ * saturates at the ends of the range instead of wrapping and the
+ * conversions round half away from zero. No float is used except by
+ * fromFloat and toFloat.
+ * The int32_t representation of an HX711Weight has the range of a raw
+ * reading, so HX711Tracker, HX711Predictor, HX711Quantile and HX711Spc
+ * filter it like one: pass getRaw() to keep the fraction, give their
+ * tolerance or limits times 256 and turn their results back with
+ * fromRaw, or fromFloat of the result / 256. HX711Quantile keeps its
+ * estimates in float with 24 bits, so the fraction only survives up to
+ * 65536 units, above that it rounds like a whole unit reading would
+ */
+template<uint8_t Q>
+class HX711Fixed {
+	static_assert(Q >= 1 && Q <= 16, "Q must be 1 to 16");
+public:
+	HX711Fixed() {
+		_raw = 0;
+	}
+
+	/*
+	 * makes a value from its int32_t representation
+	 */
+	static HX711Fixed fromRaw(int32_t raw) {
+		HX711Fixed value;
+		value._raw = raw;
+		return value;
+	}
+
+	/*
+	 * makes a value from a whole number
+	 */
+	static HX711Fixed fromInt(int32_t whole) {
+		if (whole > (INT32_MAX >> Q))
+			return fromRaw(INT32_MAX);
+		if (whole < (INT32_MIN >> Q))
+			return fromRaw(INT32_MIN);
+		return fromRaw(int32_t(uint32_t(whole) << Q));
+	}
+
+	/*
+	 * makes a value from a float
+	 */
+	static HX711Fixed fromFloat(float number) {
+		number *= float(uint32_t(1) << Q);
+		if (number >= 2147483520.0f)
+			return fromRaw(INT32_MAX);
+		if (number <= -2147483648.0f)
+			return fromRaw(INT32_MIN);
+		return fromRaw(int32_t(number < 0 ? number - 0.5f : number + 0.5f));
+	}
+
+	/*
+	 * makes the rounded quotient of two whole numbers, for instance a
+	 * reading and the adjuster. A zero denominator saturates
+	 */
+	static HX711Fixed fromRatio(int32_t numerator, int32_t denominator) {
+		uint32_t magnitude, divisor, whole, fraction;
+		bool negative = (numerator < 0) != (denominator < 0);
+
+		if (!denominator)
+			return fromRaw(!numerator ? 0 : (numerator > 0 ? INT32_MAX : INT32_MIN));
+		magnitude = numerator < 0 ? 0 - uint32_t(numerator) : numerator;
+		divisor = denominator < 0 ? 0 - uint32_t(denominator) : denominator;
+		whole = magnitude / divisor;
+		magnitude -= whole * divisor;
+		if (whole > (uint32_t(1) << (31 - Q)))
+			return fromRaw(negative ? INT32_MIN : INT32_MAX);
+		/*
+		 * the remainder is below the divisor, the shift and the rounding
+		 * half only fit 32 bits for divisors below 2^(31 - Q)
+		 */
+		if (divisor < (uint32_t(1) << (31 - Q)))
+			fraction = ((magnitude << Q) + divisor / 2) / divisor;
+		else
+			fraction = ((uint64_t(magnitude) << Q) + divisor / 2) / divisor;
+		magnitude = (whole << Q) + fraction;
+		if (negative)
+			return fromRaw(magnitude > uint32_t(1) << 31 ?
+					INT32_MIN : int32_t(0 - magnitude));
+		return fromRaw(magnitude > INT32_MAX ? INT32_MAX : int32_t(magnitude));
+	}
+
+	/*
+	 * returns the int32_t representation
+	 */
+	int32_t getRaw() const {
+		return _raw;
+	}
+
+	/*
+	 * returns the nearest whole number
+	 */
+	int32_t toInt() const {
+		uint32_t magnitude = _raw < 0 ? 0 - uint32_t(_raw) : _raw;
+
+		magnitude = (magnitude + (uint32_t(1) << (Q - 1))) >> Q;
+		return _raw < 0 ? -int32_t(magnitude) : int32_t(magnitude);
+	}
+
+	float toFloat() const {
+		return _raw / float(uint32_t(1) << Q);
+	}
+
+	HX711Fixed operator+(HX711Fixed other) const {
+		int32_t sum;
+		if (__builtin_add_overflow(_raw, other._raw, &sum))
+			return fromRaw(_raw < 0 ? INT32_MIN : INT32_MAX);
+		return fromRaw(sum);
+	}
+
+	HX711Fixed operator-(HX711Fixed other) const {
+		int32_t difference;
+		if (__builtin_sub_overflow(_raw, other._raw, &difference))
+			return fromRaw(_raw < 0 ? INT32_MIN : INT32_MAX);
+		return fromRaw(difference);
+	}
+
+	HX711Fixed operator-() const {
+		return fromRaw(_raw == INT32_MIN ? INT32_MAX : -_raw);
+	}
+
+	/*
+	 * the product is rounded to Q fractional bits
+	 */
+	HX711Fixed operator*(HX711Fixed other) const {
+		int64_t product = int64_t(_raw) * other._raw;
+
+		product += product < 0 ? -(int64_t(1) << (Q - 1)) : int64_t(1) << (Q - 1);
+		product /= int64_t(1) << Q;
+		if (product > INT32_MAX)
+			return fromRaw(INT32_MAX);
+		if (product < INT32_MIN)
+			return fromRaw(INT32_MIN);
+		return fromRaw(product);
+	}
+
+	HX711Fixed operator*(int32_t factor) const {
+		int32_t product;
+		if (__builtin_mul_overflow(_raw, factor, &product))
+			return fromRaw((_raw < 0) != (factor < 0) ? INT32_MIN : INT32_MAX);
+		return fromRaw(product);
+	}
+
+	/*
+	 * the quotient is rounded, a zero divisor saturates
+	 */
+	HX711Fixed operator/(int32_t divisor) const {
+		uint32_t magnitude = _raw < 0 ? 0 - uint32_t(_raw) : _raw;
+		uint32_t absolute = divisor < 0 ? 0 - uint32_t(divisor) : divisor;
+		uint32_t quotient;
+
+		if (!divisor)
+			return fromRaw(!_raw ? 0 : (_raw > 0 ? INT32_MAX : INT32_MIN));
+		quotient = magnitude / absolute;
+		magnitude -= quotient * absolute;
+		if (magnitude >= absolute - magnitude)
+			++quotient;
+		if ((_raw < 0) != (divisor < 0))
+			return fromRaw(int32_t(0 - quotient));
+		return fromRaw(quotient > INT32_MAX ? INT32_MAX : int32_t(quotient));
+	}
+
+	HX711Fixed &operator+=(HX711Fixed other) {
+		return *this = *this + other;
+	}
+
+	HX711Fixed &operator-=(HX711Fixed other) {
+		return *this = *this - other;
+	}
+
+	bool operator==(HX711Fixed other) const {
+		return _raw == other._raw;
+	}
+
+	bool operator!=(HX711Fixed other) const {
+		return _raw != other._raw;
+	}
+
+	bool operator<(HX711Fixed other) const {
+		return _raw < other._raw;
+	}
+
+	bool operator>(HX711Fixed other) const {
+		return _raw > other._raw;
+	}
+
+	bool operator<=(HX711Fixed other) const {
+		return _raw <= other._raw;
+	}
+
+	bool operator>=(HX711Fixed other) const {
+		return _raw >= other._raw;
+	}
+
+	/*
+	 * writes the value rounded to decimals (0 to HX711FIXED_DECIMALS)
+	 * with a point, buffer must hold HX711FIXED_TEXT characters.
+	 * Returns the length. Only 32 bit integer operations are used
+	 */
+	uint8_t format(char *buffer, uint8_t decimals) const {
+		static const uint16_t powers[] = { 1, 10, 100, 1000, 10000 };
+		uint32_t magnitude = _raw < 0 ? 0 - uint32_t(_raw) : _raw;
+		uint32_t whole = magnitude >> Q, fraction;
+		uint16_t power;
+		char digits[10];
+		uint8_t length = 0, count = 0, i;
+
+		if (decimals > HX711FIXED_DECIMALS)
+			decimals = HX711FIXED_DECIMALS;
+		power = powers[decimals];
+		fraction = ((magnitude & ((uint32_t(1) << Q) - 1)) * power
+				+ (uint32_t(1) << (Q - 1))) >> Q;
+		if (fraction >= power) {
+			fraction -= power;
+			++whole;
+		}
+		if (_raw < 0 && (whole || fraction))
+			buffer[length++] = '-';
+		do {
+			digits[count++] = '0' + whole % 10;
+			whole /= 10;
+		} while (whole);
+		while (count)
+			buffer[length++] = digits[--count];
+		if (decimals) {
+			buffer[length++] = '.';
+			for (i = decimals; i; --i) {
+				buffer[length + i - 1] = '0' + fraction % 10;
+				fraction /= 10;
+			}
+			length += decimals;
+		}
+		buffer[length] = 0;
+		return length;
+	}
+
+private:
+	int32_t _raw;
+};
+
+typedef HX711Fixed<8> HX711Weight;
+
+#endif //  HX711FIXED_H
@@ -0,0 +1,199 @@
+#include "HX711Frame.h"
+
+/*
+ * CRC-16/CCITT with polynomial 0x1021 and 0xFFFF as start value,
+ * bitwise so it needs no table in flash
+ */
+static uint16_t crc16(const uint8_t *data, uint8_t length) {
+	uint16_t crc = 0xFFFF;
+	uint8_t bit;
+
+	while (length--) {
+		crc ^= uint16_t(*data++) << 8;
+		for (bit = 0; bit < 8; ++bit)
+			crc = crc & 0x8000 ? (crc << 1) ^ 0x1021 : crc << 1;
+	}
+	return crc;
+}
+
+static void putLong(uint8_t *data, uint32_t value) {
+	data[0] = value;
+	data[1] = value >> 8;
+	data[2] = value >> 16;
+	data[3] = value >> 24;
+}
+
+static uint32_t getLong(const uint8_t *data) {
+	return data[0] | uint32_t(data[1]) << 8 | uint32_t(data[2]) << 16
+			| uint32_t(data[3]) << 24;
+}
+
+/*
+ * Makes an encoder for the samples of a node, the node number is
+ * optional and defaults to 0
+ */
+
+HX711FrameEncoder::HX711FrameEncoder(uint8_t node) {
+	_node = node;
+	_sequence = 0;
+}
+
+/*
+ * encodes the sample in frame, which must have room for HX711FRAME_SIZE
+ * bytes, returns the amount of bytes to send. For instance:
+ *   Serial.write(frame, encoder.encode(sample, frame));
+ */
+uint8_t HX711FrameEncoder::encode(const HX711Sample &sample, uint8_t *frame) {
+	uint8_t payload[HX711FRAME_PAYLOAD];
+	uint8_t i, code = 0, length = 1;
+	uint16_t crc;
+
+	payload[0] = _node;
+	payload[1] = _sequence++;
+	putLong(payload + 2, sample.timestamp);
+	putLong(payload + 6, sample.raw);
+	crc = crc16(payload, HX711FRAME_PAYLOAD - 2);
+	payload[10] = crc;
+	payload[11] = crc >> 8;
+
+	/*
+	 * every zero is replaced by the distance to the next zero, the first
+	 * byte holds the distance to the first zero. The payload is shorter
+	 * than 254 bytes so no extra code bytes are needed
+	 */
+	for (i = 0; i < HX711FRAME_PAYLOAD; ++i) {
+		if (payload[i]) {
+			frame[length++] = payload[i];
+		} else {
+			frame[code] = length - code;
+			code = length++;
+		}
+	}
+	frame[code] = length - code;
+	frame[length++] = 0;
+	return length;
+}
+
+/*
+ * returns the node number
+ */
+uint8_t HX711FrameEncoder::getNode() {
+	return _node;
+}
+
+/*
+ * Makes a decoder for the byte stream of one node
+ */
+
+HX711FrameDecoder::HX711FrameDecoder() {
+	begin();
+	_frames = 0;
+	_errors = 0;
+	_lost = 0;
+}
+
+/*
+ * starts over, for instance after the link is reopened. The bytes up to
+ * the first zero are dropped as they may be the end of a frame
+ */
+void HX711FrameDecoder::begin() {
+	_length = 0;
+	_code = 0;
+	_left = 0;
+	_overflow = false;
+	_synced = false;
+	_started = false;
+}
+
+/*
+ * decodes bytes until a frame is complete or all length bytes are used,
+ * returns the amount of bytes used. complete is set when frame holds a
+ * new frame, call it again with the remaining bytes. Frames with a wrong
+ * length or CRC are counted as errors and dropped
+ */
+size_t HX711FrameDecoder::decode(const uint8_t *data, size_t length,
+		HX711Frame &frame, bool &complete) {
+	size_t used = 0;
+	uint8_t byte, code;
+
+	complete = false;
+	while (used < length) {
+		byte = data[used++];
+		if (!byte) {
+			if (_synced && (_length || _code))
+				complete = finish(frame);
+			_synced = true;
+			_length = 0;
+			_code = 0;
+			_left = 0;
+			_overflow = false;
+			if (complete)
+				return used;
+			continue;
+		}
+		if (!_synced)
+			continue;
+		if (_left) {
+			--_left;
+		} else {
+			/*
+			 * a code byte, the zero it stands for ends the previous
+			 * block unless that block was a full 254 bytes
+			 */
+			code = _code;
+			_code = byte;
+			_left = byte - 1;
+			if (!code || code == 0xFF)
+				continue;
+			byte = 0;
+		}
+		if (_length < sizeof(_buffer))
+			_buffer[_length++] = byte;
+		else
+			_overflow = true;
+	}
+	return used;
+}
+
+/*
+ * checks the decoded payload and fills the frame
+ */
+bool HX711FrameDecoder::finish(HX711Frame &frame) {
+	if (_overflow || _left || _length != HX711FRAME_PAYLOAD
+			|| crc16(_buffer, HX711FRAME_PAYLOAD - 2)
+					!= (_buffer[10] | (_buffer[11] << 8))) {
+		++_errors;
+		return false;
+	}
+	frame.node = _buffer[0];
+	frame.sequence = _buffer[1];
+	frame.sample.timestamp = getLong(_buffer + 2);
+	frame.sample.raw = getLong(_buffer + 6);
+	if (_started)
+		_lost += uint8_t(frame.sequence - _sequence - 1);
+	_sequence = frame.sequence;
+	_started = true;
+	++_frames;
+	return true;
+}
+
+/*
+ * returns the amount of valid frames
+ */
+uint32_t HX711FrameDecoder::getFrames() {
+	return _frames;
+}
+
+/*
+ * returns the amount of damaged frames
+ */
+uint32_t HX711FrameDecoder::getErrors() {
+	return _errors;
+}
+
+/*
+ * returns the amount of frames missing in the sequence numbers
+ */
+uint32_t HX711FrameDecoder::getLost() {
+	return _lost;
+}
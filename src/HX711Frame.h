@@ -0,0 +1,87 @@
+#ifndef HX711FRAME_H
+#define HX711FRAME_H
+
+/*
+ * Framing of samples for a serial link, COBS encoded with a CRC so
+ * a host can decode a byte stream incrementally and resynchronize.
+ *
+ * Copyright (C) 2016 Edwin Croissant
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * See the README.md file for additional information.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include "HX711Sample.h"
+
+/*
+ * A frame holds the node number, a sequence number, the timestamp and
+ * the raw reading (both least significant byte first) and a CRC-16/CCITT
+ * over them, 12 bytes. They are COBS encoded so the frame contains
+ * no zeros and a zero ends it, which makes HX711FRAME_SIZE bytes on the
+ * link. A receiver that starts in the middle of a frame drops it and
+ * is in sync from the next zero.
+ */
+#define HX711FRAME_PAYLOAD 12
+#define HX711FRAME_SIZE (HX711FRAME_PAYLOAD + 2)
+
+/*
+ * a decoded frame, the sequence counts the frames of a node
+ * modulo 256 so the receiver can count lost frames
+ */
+struct HX711Frame {
+	uint8_t node;
+	uint8_t sequence;
+	HX711Sample sample;
+};
+
+class HX711FrameEncoder {
+public:
+	HX711FrameEncoder(uint8_t node = 0);
+	uint8_t encode(const HX711Sample &sample, uint8_t *frame);
+	uint8_t getNode();
+
+private:
+	uint8_t _node;
+	uint8_t _sequence;
+};
+
+class HX711FrameDecoder {
+public:
+	HX711FrameDecoder();
+	void begin();
+	size_t decode(const uint8_t *data, size_t length, HX711Frame &frame,
+			bool &complete);
+	uint32_t getFrames();
+	uint32_t getErrors();
+	uint32_t getLost();
+
+private:
+	bool finish(HX711Frame &frame);
+	uint8_t _buffer[HX711FRAME_PAYLOAD];
+	uint8_t _length;
+	uint8_t _code;
+	uint8_t _left;
+	bool _overflow;
+	bool _synced;
+	bool _started;
+	uint8_t _sequence;
+	uint32_t _frames;
+	uint32_t _errors;
+	uint32_t _lost;
+};
+
+#endif //  HX711FRAME_H
@@ -0,0 +1,133 @@
+#include "HX711Hysteresis.h"
+
+/*
+ * Makes a model, amplitude is half the difference between unloading and
+ * loading, width the load over which a branch settles and threshold the
+ * noise a reversal must exceed, all in the units of the values.
+ * The defaults correct nothing
+ */
+
+HX711Hysteresis::HX711Hysteresis(float amplitude, float width,
+		int32_t threshold) {
+	_amplitude = amplitude;
+	_width = width > 0 ? width : 1;
+	_threshold = threshold > 0 ? threshold : 0;
+	reset();
+}
+
+/*
+ * forgets the load history, the next value starts a loading branch
+ * without error like a cell that has been unloaded for a while
+ */
+void HX711Hysteresis::reset() {
+	_started = false;
+	_direction = 1;
+	_turningPoint = 0;
+	_turningError = 0;
+	_extreme = 0;
+	_error = 0;
+}
+
+/*
+ * updates the history with a value and returns it minus the error
+ */
+int32_t HX711Hysteresis::correct(int32_t value) {
+	float distance;
+
+	if (!_started) {
+		_started = true;
+		_turningPoint = value;
+		_extreme = value;
+	}
+	/*
+	 * the extreme in the direction of the load, a value more than
+	 * threshold back from it makes it the next turning point
+	 */
+	if (_direction > 0 ? value > _extreme : value < _extreme)
+		_extreme = value;
+	else if ((_direction > 0 ? float(_extreme) - value :
+			float(value) - _extreme) > _threshold) {
+		distance = _direction * (float(_extreme) - _turningPoint);
+		_turningError = -_direction * _amplitude
+				+ (_turningError + _direction * _amplitude)
+						* expf(-distance / _width);
+		_turningPoint = _extreme;
+		_direction = -_direction;
+		_extreme = value;
+	}
+	/*
+	 * the error on the branch from the turning point, values behind
+	 * the turning point (noise) keep its error
+	 */
+	distance = _direction * (float(value) - _turningPoint);
+	if (distance < 0)
+		distance = 0;
+	_error = -_direction * _amplitude
+			+ (_turningError + _direction * _amplitude) * expf(-distance / _width);
+	return value - int32_t(_error < 0 ? _error - 0.5f : _error + 0.5f);
+}
+
+/*
+ * returns the error subtracted from the last value
+ */
+float HX711Hysteresis::getError() {
+	return _error;
+}
+
+/*
+ * returns 1 while loading and -1 while unloading
+ */
+int8_t HX711Hysteresis::getDirection() {
+	return _direction;
+}
+
+/*
+ * returns the value where the direction last turned
+ */
+int32_t HX711Hysteresis::getTurningPoint() {
+	return _turningPoint;
+}
+
+/*
+ * sets half the difference between the unloading and loading readings
+ * the branches settle to
+ */
+void HX711Hysteresis::setAmplitude(float amplitude) {
+	_amplitude = amplitude;
+}
+
+/*
+ * returns the amplitude
+ */
+float HX711Hysteresis::getAmplitude() {
+	return _amplitude;
+}
+
+/*
+ * sets the load change over which a branch settles
+ * to 1 - 1/e of the amplitude
+ */
+void HX711Hysteresis::setWidth(float width) {
+	_width = width > 0 ? width : 1;
+}
+
+/*
+ * returns the width
+ */
+float HX711Hysteresis::getWidth() {
+	return _width;
+}
+
+/*
+ * sets the change against the direction that counts as a reversal
+ */
+void HX711Hysteresis::setThreshold(int32_t threshold) {
+	_threshold = threshold > 0 ? threshold : 0;
+}
+
+/*
+ * returns the threshold
+ */
+int32_t HX711Hysteresis::getThreshold() {
+	return _threshold;
+}
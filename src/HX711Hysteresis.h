@@ -0,0 +1,67 @@
+#ifndef HX711HYSTERESIS_H
+#define HX711HYSTERESIS_H
+
+/*
+ * Loading and unloading hysteresis compensation of a load cell.
+ *
+ * Copyright (C) 2016 Edwin Croissant
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * See the README.md file for additional information.
+ */
+
+#include "Arduino.h"
+#include "HX711Corrector.h"
+
+/*
+ * A load cell reads lower on the way up than on the way down. The model
+ * keeps the direction of the load and its last turning point: from there
+ * the error approaches -amplitude while loading and +amplitude while
+ * unloading, exponentially over width (in the units of the values). The
+ * error at the turning point carries the history into the next branch,
+ * so small reversals only make small loops. A reversal counts once the
+ * value moved more than threshold back from its extreme, which keeps
+ * noise from turning the direction. HX711HysteresisFit in extras/host
+ * finds amplitude and width from recorded load cycles
+ */
+class HX711Hysteresis: public HX711Corrector {
+public:
+	HX711Hysteresis(float amplitude = 0, float width = 1,
+			int32_t threshold = 0);
+	void reset();
+	int32_t correct(int32_t value);
+	float getError();
+	int8_t getDirection();
+	int32_t getTurningPoint();
+	void setAmplitude(float amplitude);
+	float getAmplitude();
+	void setWidth(float width);
+	float getWidth();
+	void setThreshold(int32_t threshold);
+	int32_t getThreshold();
+
+private:
+	float _amplitude;
+	float _width;
+	int32_t _threshold;
+	bool _started;
+	int8_t _direction;
+	int32_t _turningPoint;
+	float _turningError;
+	int32_t _extreme;
+	float _error;
+};
+
+#endif //  HX711HYSTERESIS_H
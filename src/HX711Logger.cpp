@@ -0,0 +1,145 @@
+#include "HX711Logger.h"
+
+/*
+ * Makes a logger that packs samples in blocks of 512 bytes. While one
+ * block is filled by add() the other one is written to the backend in
+ * slices of slice bytes per service() call, so a slow storage never
+ * stalls the loop for long. slice is optional and defaults to 64 bytes.
+ * Call add() from read() with SimpleHX711::setOnRead and call
+ * service() from the loop.
+ */
+
+HX711Logger::HX711Logger(HX711LogBackend &backend, uint16_t slice) :
+		_backend(backend) {
+	_slice = slice ? slice : 1;
+	begin();
+}
+
+/*
+ * starts a new log, samples not yet written are discarded
+ */
+void HX711Logger::begin() {
+	_active = 0;
+	_flushing = false;
+	_offset = 0;
+	_sequence = 0;
+	_written = 0;
+	_dropped = 0;
+	_blocks[0].sequence = 0;
+	_blocks[0].count = 0;
+	_blocks[0].dropped = 0;
+}
+
+/*
+ * hands the active block over to be written and starts filling
+ * the other one, when the other one is still being written
+ * nothing happens
+ */
+void HX711Logger::queue() {
+	HX711LogBlock *block;
+
+	if (_flushing)
+		return;
+	_flushing = true;
+	_offset = 0;
+	_active ^= 1;
+	block = &_blocks[_active];
+	block->sequence = ++_sequence;
+	block->count = 0;
+	block->dropped = 0;
+}
+
+/*
+ * adds a sample to the active block, the timestamp is
+ * in millis as returned by SimpleHX711::getTimestamp()
+ */
+void HX711Logger::add(int32_t raw, uint32_t timestamp) {
+	HX711LogBlock *block = &_blocks[_active];
+
+	if (block->count >= HX711LOGGER_SAMPLES) {
+		queue();
+		block = &_blocks[_active];
+		if (block->count >= HX711LOGGER_SAMPLES) {
+			/*
+			 * both blocks are full, the storage is too slow
+			 */
+			++_dropped;
+			if (block->dropped < 0xFFFF)
+				++block->dropped;
+			return;
+		}
+	}
+	block->samples[block->count].timestamp = timestamp;
+	block->samples[block->count].raw = raw;
+	if (++block->count >= HX711LOGGER_SAMPLES)
+		queue();
+}
+
+/*
+ * writes at most one slice of the full block to the backend
+ * returns true while there is a block being written
+ */
+bool HX711Logger::service() {
+	size_t length;
+
+	if (!_flushing)
+		return false;
+	length = sizeof(HX711LogBlock) - _offset;
+	if (length > _slice)
+		length = _slice;
+	_offset += _backend.write(
+			reinterpret_cast<const uint8_t*>(&_blocks[_active ^ 1]) + _offset,
+			length);
+	if (_offset >= sizeof(HX711LogBlock)) {
+		_flushing = false;
+		++_written;
+		/*
+		 * the active block may have filled up in the meantime
+		 */
+		if (_blocks[_active].count >= HX711LOGGER_SAMPLES)
+			queue();
+	}
+	return _flushing;
+}
+
+/*
+ * writes all samples including the partly filled block, this blocks
+ * until the backend accepted everything so call it at the end of a log
+ */
+void HX711Logger::flush() {
+	while (service())
+		;
+	if (_blocks[_active].count) {
+		queue();
+		while (service())
+			;
+	}
+}
+
+/*
+ * returns the amount of blocks written to the backend
+ */
+uint32_t HX711Logger::getBlocks() {
+	return _written;
+}
+
+/*
+ * returns the amount of samples lost because the storage was too slow
+ */
+uint32_t HX711Logger::getDropped() {
+	return _dropped;
+}
+
+/*
+ * sets the maximum amount of bytes written per service() call
+ */
+void HX711Logger::setSlice(uint16_t slice) {
+	_slice = slice ? slice : 1;
+}
+
+/*
+ * returns the maximum amount of bytes written per service() call
+ */
+uint16_t HX711Logger::getSlice() {
+	return _slice;
+}
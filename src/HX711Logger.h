@@ -0,0 +1,121 @@
+#ifndef HX711LOGGER_H
+#define HX711LOGGER_H
+
+/*
+ * Double buffered block logger for the SimpleHX711 library.
+ *
+ * Copyright (C) 2016 Edwin Croissant
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * See the README.md file for additional information.
+ */
+
+#ifdef ARDUINO
+#include "Arduino.h"
+#else
+#include <stddef.h>
+#include <stdio.h>
+#endif
+#include "HX711Sample.h"
+
+/*
+ * the amount of samples in a block of 512 bytes
+ * and the default amount of bytes written per service() call
+ */
+#define HX711LOGGER_SAMPLES 63
+#define HX711LOGGER_SLICE 64
+
+/*
+ * a block as written to the storage, sequence counts the blocks since
+ * begin(), count is the amount of valid samples and dropped is the
+ * amount of samples lost after this block because the storage was too slow
+ */
+struct HX711LogBlock {
+	uint32_t sequence;
+	uint16_t count;
+	uint16_t dropped;
+	HX711Sample samples[HX711LOGGER_SAMPLES];
+};
+static_assert(sizeof(HX711LogBlock) == 512, "a block must be 512 bytes");
+
+/*
+ * where the blocks go, write returns the amount of bytes accepted
+ * which may be less than length when the storage is busy
+ */
+class HX711LogBackend {
+public:
+	virtual ~HX711LogBackend() {
+	}
+	virtual size_t write(const uint8_t *data, size_t length) = 0;
+};
+
+#ifdef ARDUINO
+/*
+ * writes to anything that prints, for instance an SD File
+ */
+class HX711PrintBackend: public HX711LogBackend {
+public:
+	HX711PrintBackend(Print &out) :
+			_out(out) {
+	}
+	size_t write(const uint8_t *data, size_t length) {
+		return _out.write(data, length);
+	}
+private:
+	Print &_out;
+};
+#else
+/*
+ * writes to a file on the host, for testing sustained rates
+ */
+class HX711FileBackend: public HX711LogBackend {
+public:
+	HX711FileBackend(FILE *file) :
+			_file(file) {
+	}
+	size_t write(const uint8_t *data, size_t length) {
+		return fwrite(data, 1, length, _file);
+	}
+private:
+	FILE *_file;
+};
+#endif
+
+class HX711Logger {
+public:
+	HX711Logger(HX711LogBackend &backend, uint16_t slice = HX711LOGGER_SLICE);
+	void begin();
+	void add(int32_t raw, uint32_t timestamp);
+	bool service();
+	void flush();
+	uint32_t getBlocks();
+	uint32_t getDropped();
+	void setSlice(uint16_t slice);
+	uint16_t getSlice();
+
+private:
+	void queue();
+	HX711LogBackend &_backend;
+	uint16_t _slice;
+	HX711LogBlock _blocks[2];
+	uint8_t _active;
+	bool _flushing;
+	uint16_t _offset;
+	uint32_t _sequence;
+	uint32_t _written;
+	uint32_t _dropped;
+};
+
+#endif //  HX711LOGGER_H
@@ -0,0 +1,122 @@
+#include "HX711MCP23017.h"
+
+/*
+ * the registers with IOCON.BANK = 0, every A register is followed
+ * by its B register
+ */
+#define HX711MCP23017_IODIRA 0x00
+#define HX711MCP23017_IOCON 0x0A
+#define HX711MCP23017_GPPUA 0x0C
+#define HX711MCP23017_GPIOA 0x12
+#define HX711MCP23017_OLATA 0x14
+
+/*
+ * IOCON.SEQOP set: the address pointer toggles between
+ * the A and B register of a pair
+ */
+#define HX711MCP23017_SEQOP 0x20
+
+/*
+ * Makes an expander at address 0x20 to 0x27 on the bus
+ */
+
+HX711MCP23017::HX711MCP23017(TwoWire &wire, uint8_t address) :
+		_wire(wire) {
+	_address = address;
+	_levels = 0;
+}
+
+/*
+ * writes a register pair, A first
+ */
+bool HX711MCP23017::writeRegister(uint8_t reg, uint16_t value) {
+	_wire.beginTransmission(_address);
+	_wire.write(reg);
+	_wire.write(uint8_t(value));
+	_wire.write(uint8_t(value >> 8));
+	return _wire.endTransmission() == 0;
+}
+
+/*
+ * makes the pins in outputs low outputs and the others
+ * inputs with pull ups
+ */
+bool HX711MCP23017::setup(uint16_t outputs) {
+	_wire.beginTransmission(_address);
+	_wire.write(HX711MCP23017_IOCON);
+	_wire.write(HX711MCP23017_SEQOP);
+	if (_wire.endTransmission() != 0)
+		return false;
+	_levels = 0;
+	return writeRegister(HX711MCP23017_OLATA, 0)
+			&& writeRegister(HX711MCP23017_GPPUA, ~outputs)
+			&& writeRegister(HX711MCP23017_IODIRA, ~outputs);
+}
+
+/*
+ * sets the outputs
+ */
+bool HX711MCP23017::write(uint16_t levels) {
+	_levels = levels;
+	return writeRegister(HX711MCP23017_OLATA, levels);
+}
+
+/*
+ * pulses the pins count times in one transaction. The register of the
+ * port with the pins is written alternately high and low, every write is
+ * followed by one to the other port, so the pins are high for the time
+ * of two bytes. Returns the high time in us estimated from the time of
+ * the transaction or 0xFFFF when the expander does not respond
+ */
+uint16_t HX711MCP23017::pulse(uint16_t pins, uint8_t count) {
+	uint8_t reg, high, low, other, i;
+	uint32_t start, elapsed;
+
+	/*
+	 * the pins of a pulse are all on one port
+	 */
+	if (pins & 0xFF00) {
+		reg = HX711MCP23017_OLATA + 1;
+		high = (_levels | pins) >> 8;
+		low = (_levels & ~pins) >> 8;
+		other = _levels;
+	} else {
+		reg = HX711MCP23017_OLATA;
+		high = _levels | pins;
+		low = _levels & ~pins;
+		other = _levels >> 8;
+	}
+	start = micros();
+	_wire.beginTransmission(_address);
+	_wire.write(reg);
+	for (i = 0; i < count; ++i) {
+		_wire.write(high);
+		_wire.write(other);
+		_wire.write(low);
+		_wire.write(other);
+	}
+	if (_wire.endTransmission() != 0)
+		return 0xFFFF;
+	elapsed = micros() - start;
+	/*
+	 * 9 bits a byte, the address, the register and 4 bytes a pulse
+	 * of which the high time takes 2
+	 */
+	elapsed = elapsed * 18 / (9 * (2 + 4 * uint16_t(count)));
+	return elapsed < 0xFFFF ? elapsed : 0xFFFE;
+}
+
+/*
+ * reads all pins
+ */
+bool HX711MCP23017::read(uint16_t &levels) {
+	_wire.beginTransmission(_address);
+	_wire.write(HX711MCP23017_GPIOA);
+	if (_wire.endTransmission(false) != 0)
+		return false;
+	if (_wire.requestFrom(_address, uint8_t(2)) != 2)
+		return false;
+	levels = _wire.read();
+	levels |= uint16_t(_wire.read()) << 8;
+	return true;
+}
@@ -0,0 +1,49 @@
+#ifndef HX711MCP23017_H
+#define HX711MCP23017_H
+
+/*
+ * MCP23017 I2C port expander for HX711ExpanderBank.
+ *
+ * Copyright (C) 2016 Edwin Croissant
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * See the README.md file for additional information.
+ */
+
+#include "Arduino.h"
+#include <Wire.h>
+#include "HX711ExpanderBank.h"
+
+/*
+ * An MCP23017 on a TwoWire bus, pins 0 to 7 are GPA0 to GPA7 and pins 8
+ * to 15 are GPB0 to GPB7. Set the bus to 400 kHz or more before begin of
+ * the bank, at 100 kHz a clock pulse is longer than 60 us
+ */
+class HX711MCP23017: public HX711Expander {
+public:
+	HX711MCP23017(TwoWire &wire, uint8_t address = 0x20);
+	bool setup(uint16_t outputs);
+	bool write(uint16_t levels);
+	uint16_t pulse(uint16_t pins, uint8_t count);
+	bool read(uint16_t &levels);
+
+private:
+	bool writeRegister(uint8_t reg, uint16_t value);
+	TwoWire &_wire;
+	uint8_t _address;
+	uint16_t _levels;
+};
+
+#endif //  HX711MCP23017_H
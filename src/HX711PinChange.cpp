@@ -0,0 +1,92 @@
+#include "HX711PinChange.h"
+
+/*
+ * Makes a dispatcher without scales
+ */
+
+HX711PinChange::HX711PinChange() {
+	uint8_t bit;
+
+	for (bit = 0; bit < 8; ++bit)
+		_scales[bit] = NULL;
+	_mask = 0;
+	_levels = 0xFF;
+	_pending = 0;
+	_busy = 0;
+}
+
+/*
+ * adds a scale whose data line is bit (0 to 7) of the port, returns
+ * false when the bit is taken. Call it before enabling the interrupt
+ */
+bool HX711PinChange::add(SimpleHX711 &scale, uint8_t bit) {
+	if (bit > 7 || _scales[bit])
+		return false;
+	_scales[bit] = &scale;
+	_mask |= 1 << bit;
+	return true;
+}
+
+/*
+ * call it from the pin change interrupt with the levels of the port,
+ * a data line that went low is a new conversion
+ */
+void HX711PinChange::interrupt(uint8_t levels) {
+	_pending = _pending | (_levels & ~levels & _mask & ~_busy);
+	_levels = levels;
+}
+
+/*
+ * queues every scale with its data line low in levels, at the start
+ * or when an edge was missed
+ */
+void HX711PinChange::check(uint8_t levels) {
+	noInterrupts();
+	_pending = _pending | (~levels & _mask & ~_busy);
+	_levels = levels;
+	interrupts();
+}
+
+/*
+ * reads the scales with a new conversion, lowest bit first,
+ * returns the amount of scales read
+ */
+uint8_t HX711PinChange::service() {
+	uint8_t pending, bit, reads = 0;
+
+	noInterrupts();
+	pending = _pending;
+	_pending = 0;
+	interrupts();
+	while (pending) {
+		bit = __builtin_ctz(pending);
+		pending &= pending - 1;
+		_busy = 1 << bit;
+		if (_scales[bit]->read())
+			++reads;
+		/*
+		 * after the read the data line is high until the next conversion,
+		 * the edges during the read were the data bits
+		 */
+		noInterrupts();
+		_busy = 0;
+		_levels = _levels | (1 << bit);
+		_pending = _pending & ~(1 << bit);
+		interrupts();
+	}
+	return reads;
+}
+
+/*
+ * returns the mask of scales waiting for service
+ */
+uint8_t HX711PinChange::getPending() {
+	return _pending;
+}
+
+/*
+ * returns the mask of the data lines of the scales
+ */
+uint8_t HX711PinChange::getMask() {
+	return _mask;
+}
@@ -0,0 +1,62 @@
+#ifndef HX711PINCHANGE_H
+#define HX711PINCHANGE_H
+
+/*
+ * Pin change interrupt dispatcher for up to 8 HX711 chips with their
+ * own clocks and their data lines on one port.
+ *
+ * Copyright (C) 2016 Edwin Croissant
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * See the README.md file for additional information.
+ */
+
+#include "Arduino.h"
+#include "SimpleHX711.h"
+
+/*
+ * The data lines of the scales are bits of one port, for instance PINB
+ * on AVR, with the pin change interrupt of the port enabled for them:
+ *
+ *   ISR(PCINT0_vect) {
+ *       dispatcher.interrupt(PINB);
+ *   }
+ *
+ * interrupt finds the data lines that went low since the last call, the
+ * scales with a new conversion, and adds them to a pending mask. service
+ * reads only those scales, so neither depends on the amount of scales.
+ * Edges while a scale is read are its own data bits and are ignored. An
+ * edge can be missed when the port changes twice before the interrupt
+ * reads it, check queues every low data line to recover from that
+ */
+class HX711PinChange {
+public:
+	HX711PinChange();
+	bool add(SimpleHX711 &scale, uint8_t bit);
+	void interrupt(uint8_t levels);
+	void check(uint8_t levels);
+	uint8_t service();
+	uint8_t getPending();
+	uint8_t getMask();
+
+private:
+	SimpleHX711 *_scales[8];
+	uint8_t _mask;
+	volatile uint8_t _levels;
+	volatile uint8_t _pending;
+	volatile uint8_t _busy;
+};
+
+#endif //  HX711PINCHANGE_H
@@ -0,0 +1,176 @@
+#include "HX711Predictor.h"
+
+/*
+ * The output of a loaded scale approaches its final value as an exponential,
+ * so the differences between consecutive readings form a geometric series
+ * d(k) = rho * d(k-1). Rho is estimated with a running least squares fit and
+ * the remainder of the series, d * rho / (1 - rho), is added to the last
+ * reading to predict the final value long before the output has settled.
+ *
+ * tolerance sets the maximum confidence bound for which the prediction is
+ * considered within tolerance, minSamples sets the amount of readings
+ * required before a prediction can be within tolerance.
+ * Call reset when a new load is placed on the scale.
+ */
+
+HX711Predictor::HX711Predictor(int32_t tolerance, uint8_t minSamples) {
+	_tolerance = tolerance;
+	_minSamples = minSamples;
+	reset();
+}
+
+/*
+ * clamps a float to the range of an int32_t
+ */
+static int32_t toInt32(float value) {
+	if (value >= 2147483520.0)
+		return INT32_MAX;
+	if (value <= -2147483520.0)
+		return INT32_MIN;
+	return value < 0 ? int32_t(value - 0.5) : int32_t(value + 0.5);
+}
+
+/*
+ * forget all previous readings, call this when a new load
+ * is placed on the scale
+ */
+void HX711Predictor::reset() {
+	_count = 0;
+	_last = 0;
+	_lastDelta = 0;
+	_sxx = 0;
+	_sxy = 0;
+	_syy = 0;
+	_prediction = 0;
+	_bound = INT32_MAX;
+}
+
+/*
+ * adds a reading and updates the prediction and its confidence bound
+ */
+void HX711Predictor::add(int32_t value) {
+	float delta, rho, variance;
+	uint8_t pairs;
+
+	if (!_count) {
+		_last = value;
+		_prediction = value;
+		_bound = INT32_MAX;
+		_count = 1;
+		return;
+	}
+
+	delta = float(value) - float(_last);
+	/*
+	 * the first difference has no predecessor to pair with, the sums
+	 * stop with the count at 255 readings so they keep matching it
+	 */
+	if (_count >= 2 && _count < 255) {
+		_sxx += _lastDelta * _lastDelta;
+		_sxy += delta * _lastDelta;
+		_syy += delta * delta;
+	}
+	_lastDelta = delta;
+	_last = value;
+	if (_count < 255)
+		++_count;
+
+	_prediction = value;
+	_bound = INT32_MAX;
+	/*
+	 * at least two pairs of differences are required to
+	 * estimate the noise
+	 */
+	if (_count < 4 || _sxx <= 0)
+		return;
+
+	rho = _sxy / _sxx;
+	pairs = _count - 2;
+	/*
+	 * the residual sum of squares of the fit, expanded so it can be
+	 * calculated from the running sums
+	 */
+	variance = _syy - rho * _sxy;
+	if (variance < 0)
+		variance = 0;
+	variance /= pairs - 1;
+
+	if (rho <= 0) {
+		/*
+		 * the differences are dominated by noise so the
+		 * output has already settled
+		 */
+		_bound = toInt32(2 * sqrt(variance));
+	} else if (rho < 0.98) {
+		/*
+		 * the bound is two standard deviations of the reading noise
+		 * plus the propagated uncertainty of rho
+		 */
+		_prediction = toInt32(value + delta * rho / (1 - rho));
+		_bound = toInt32(
+				2 * (fabs(delta) * sqrt(variance / _sxx)
+						/ ((1 - rho) * (1 - rho)) + sqrt(variance)));
+	}
+	/*
+	 * with rho close to one the settling is too slow to extrapolate
+	 */
+}
+
+/*
+ * returns the predicted final value
+ */
+int32_t HX711Predictor::getPrediction() {
+	return _prediction;
+}
+
+/*
+ * returns the confidence bound (about two standard deviations)
+ * of the prediction
+ */
+int32_t HX711Predictor::getBound() {
+	return _bound;
+}
+
+/*
+ * returns true when enough readings are taken and the confidence
+ * bound is smaller than or equal to the tolerance
+ */
+bool HX711Predictor::isWithinTolerance() {
+	return _count >= _minSamples && _bound <= _tolerance;
+}
+
+/*
+ * returns the amount of readings since the last reset, saturates at 255
+ */
+uint8_t HX711Predictor::getCount() {
+	return _count;
+}
+
+/*
+ * sets the maximum confidence bound for isWithinTolerance
+ */
+void HX711Predictor::setTolerance(int32_t tolerance) {
+	_tolerance = tolerance;
+}
+
+/*
+ * returns the tolerance
+ */
+int32_t HX711Predictor::getTolerance() {
+	return _tolerance;
+}
+
+/*
+ * sets the amount of readings required before isWithinTolerance
+ * can return true
+ */
+void HX711Predictor::setMinSamples(uint8_t minSamples) {
+	_minSamples = minSamples;
+}
+
+/*
+ * returns the minimum amount of readings
+ */
+uint8_t HX711Predictor::getMinSamples() {
+	return _minSamples;
+}
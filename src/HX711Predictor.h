@@ -0,0 +1,55 @@
+#ifndef HX711PREDICTOR_H
+#define HX711PREDICTOR_H
+
+/*
+ * Final weight prediction from the settling curve for the
+ * SimpleHX711 library.
+ *
+ * Copyright (C) 2016 Edwin Croissant
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * See the README.md file for additional information.
+ */
+
+#include "Arduino.h"
+
+class HX711Predictor {
+public:
+	HX711Predictor(int32_t tolerance = 1, uint8_t minSamples = 4);
+	void reset();
+	void add(int32_t value);
+	int32_t getPrediction();
+	int32_t getBound();
+	bool isWithinTolerance();
+	uint8_t getCount();
+	void setTolerance(int32_t tolerance);
+	int32_t getTolerance();
+	void setMinSamples(uint8_t minSamples);
+	uint8_t getMinSamples();
+
+private:
+	int32_t _tolerance;
+	uint8_t _minSamples;
+	uint8_t _count;
+	int32_t _last;
+	float _lastDelta;
+	float _sxx;
+	float _sxy;
+	float _syy;
+	int32_t _prediction;
+	int32_t _bound;
+};
+
+#endif //  HX711PREDICTOR_H
@@ -0,0 +1,157 @@
+#include "HX711Quantile.h"
+
+/*
+ * Makes an estimator of the quantile probability (0 to 1), it is
+ * optional and defaults to the median
+ */
+
+HX711Quantile::HX711Quantile(float probability) {
+	_probability = constrain(probability, 0, 1);
+	reset();
+}
+
+/*
+ * forgets all values
+ */
+void HX711Quantile::reset() {
+	uint8_t marker;
+
+	_count = 0;
+	for (marker = 0; marker < 5; ++marker) {
+		_heights[marker] = 0;
+		_positions[marker] = marker;
+	}
+}
+
+/*
+ * the height of a marker moved one position in direction (1 or -1) on
+ * the parabola through it and its neighbours
+ */
+float HX711Quantile::parabolic(uint8_t marker, int8_t direction) {
+	float below = _positions[marker] - _positions[marker - 1];
+	float above = _positions[marker + 1] - _positions[marker];
+
+	return _heights[marker]
+			+ direction / (below + above)
+					* ((below + direction)
+							* (_heights[marker + 1] - _heights[marker]) / above
+							+ (above - direction)
+									* (_heights[marker] - _heights[marker - 1])
+									/ below);
+}
+
+/*
+ * adds a value
+ */
+void HX711Quantile::add(int32_t value) {
+	float height = value, moved;
+	uint32_t probability = _probability * 16777216.0f + 0.5f;
+	uint32_t desired[4] = { 0, probability / 2, probability,
+			(16777216 + probability) / 2 };
+	uint8_t marker, cell;
+	int8_t direction;
+	float offset;
+
+	/*
+	 * the first five values are the markers, sorted
+	 */
+	if (_count < 5) {
+		for (marker = _count; marker && _heights[marker - 1] > height; --marker)
+			_heights[marker] = _heights[marker - 1];
+		_heights[marker] = height;
+		++_count;
+		return;
+	}
+	++_count;
+
+	/*
+	 * the cell of the value, the extremes follow it
+	 */
+	if (height < _heights[0]) {
+		_heights[0] = height;
+		cell = 0;
+	} else if (height >= _heights[4]) {
+		_heights[4] = height;
+		cell = 3;
+	} else
+		for (cell = 0; cell < 3 && height >= _heights[cell + 1]; ++cell)
+			;
+	for (marker = cell + 1; marker < 5; ++marker)
+		++_positions[marker];
+
+	/*
+	 * the middle markers move a position when they are a position or
+	 * more off and the next marker is not in the way. Their desired
+	 * positions are computed from the count, adding the increments
+	 * would lose them in the rounding of a float after a million values.
+	 * The fractions are fixed point with 24 bits and the offset is taken
+	 * in 64 bits so it stays exact past the 2^24 values a float counts
+	 * (double is float on AVR)
+	 */
+	for (marker = 1; marker < 4; ++marker) {
+		offset = float(int64_t(uint64_t(_count - 1) * desired[marker])
+				- (int64_t(_positions[marker]) << 24)) / 16777216.0f;
+		if ((offset >= 1 && _positions[marker + 1] - _positions[marker] > 1)
+				|| (offset <= -1
+						&& _positions[marker] - _positions[marker - 1] > 1)) {
+			direction = offset > 0 ? 1 : -1;
+			moved = parabolic(marker, direction);
+			if (moved <= _heights[marker - 1] || moved >= _heights[marker + 1])
+				moved = _heights[marker]
+						+ direction
+								* (_heights[marker + direction] - _heights[marker])
+								/ float(int32_t(_positions[marker + direction]
+										- _positions[marker]));
+			_heights[marker] = moved;
+			_positions[marker] += direction;
+		}
+	}
+}
+
+/*
+ * returns the estimate of the quantile, exact for up to 5 values
+ * and 0 without values
+ */
+float HX711Quantile::getQuantile() {
+	if (!_count)
+		return 0;
+	if (_count <= 5)
+		return _heights[uint8_t(_probability * (_count - 1) + 0.5f)];
+	return _heights[2];
+}
+
+/*
+ * returns the smallest value
+ */
+float HX711Quantile::getMin() {
+	return _heights[0];
+}
+
+/*
+ * returns the largest value
+ */
+float HX711Quantile::getMax() {
+	return _count < 5 && _count ? _heights[_count - 1] : _heights[4];
+}
+
+/*
+ * returns the amount of values
+ */
+uint32_t HX711Quantile::getCount() {
+	return _count;
+}
+
+/*
+ * sets the quantile probability (0 to 1) and forgets all values
+ */
+void HX711Quantile::setProbability(float probability) {
+	_probability = constrain(probability, 0, 1);
+	reset();
+}
+
+/*
+ * returns the quantile probability
+ */
+float HX711Quantile::getProbability() {
+	return _probability;
+}
@@ -0,0 +1,56 @@
+#ifndef HX711QUANTILE_H
+#define HX711QUANTILE_H
+
+/*
+ * Streaming quantile estimate with the P-square algorithm of Jain and
+ * Chlamtac, in constant memory.
+ *
+ * Copyright (C) 2016 Edwin Croissant
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * See the README.md file for additional information.
+ */
+
+#include "Arduino.h"
+
+/*
+ * Estimates one quantile, for instance the median (0.5) or the 99th
+ * percentile (0.99), of a stream of values such as getAdjusted() of
+ * SimpleHX711, without storing them. Five markers follow the minimum,
+ * the quantile, the maximum and the quantiles halfway in between, a
+ * value moves the markers at most one position each. Use one estimator
+ * per quantile
+ */
+class HX711Quantile {
+public:
+	HX711Quantile(float probability = 0.5);
+	void reset();
+	void add(int32_t value);
+	float getQuantile();
+	float getMin();
+	float getMax();
+	uint32_t getCount();
+	void setProbability(float probability);
+	float getProbability();
+
+private:
+	float parabolic(uint8_t marker, int8_t direction);
+	float _probability;
+	uint32_t _count;
+	float _heights[5];
+	uint32_t _positions[5];
+};
+
+#endif //  HX711QUANTILE_H
@@ -0,0 +1,127 @@
+#ifndef HX711QUEUE_H
+#define HX711QUEUE_H
+
+/*
+ * Bounded lock-free queue for handing samples from a sampler task
+ * to consumer tasks, on targets with <atomic> (not AVR).
+ *
+ * Copyright (C) 2016 Edwin Croissant
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * See the README.md file for additional information.
+ */
+
+#include <atomic>
+#include <stdint.h>
+
+/*
+ * A queue of size items, size must be a power of two. Any task may push
+ * and pop, every cell has a sequence number that tells whether it is
+ * free to push to or holds an item to pop for the current lap, so the
+ * tasks never wait for each other.
+ */
+template<typename T, uint16_t size>
+class HX711Queue {
+	static_assert(size >= 2 && !(size & (size - 1)),
+			"the size must be a power of two");
+public:
+	HX711Queue() {
+		uint16_t i;
+		for (i = 0; i < size; ++i)
+			_cells[i].sequence.store(i, std::memory_order_relaxed);
+		_head.store(0, std::memory_order_relaxed);
+		_tail.store(0, std::memory_order_relaxed);
+	}
+
+	/*
+	 * adds an item, returns false when the queue is full
+	 */
+	bool push(const T &item) {
+		uint32_t position = _head.load(std::memory_order_relaxed), sequence;
+		cell *target;
+		int32_t difference;
+
+		for (;;) {
+			target = &_cells[position & (size - 1)];
+			sequence = target->sequence.load(std::memory_order_acquire);
+			difference = int32_t(sequence - position);
+			if (!difference) {
+				if (_head.compare_exchange_weak(position, position + 1,
+						std::memory_order_relaxed))
+					break;
+			} else if (difference < 0)
+				return false;
+			else
+				position = _head.load(std::memory_order_relaxed);
+		}
+		target->item = item;
+		target->sequence.store(position + 1, std::memory_order_release);
+		return true;
+	}
+
+	/*
+	 * removes the oldest item, returns false when the queue is empty
+	 */
+	bool pop(T &item) {
+		uint32_t position = _tail.load(std::memory_order_relaxed), sequence;
+		cell *source;
+		int32_t difference;
+
+		for (;;) {
+			source = &_cells[position & (size - 1)];
+			sequence = source->sequence.load(std::memory_order_acquire);
+			difference = int32_t(sequence - (position + 1));
+			if (!difference) {
+				if (_tail.compare_exchange_weak(position, position + 1,
+						std::memory_order_relaxed))
+					break;
+			} else if (difference < 0)
+				return false;
+			else
+				position = _tail.load(std::memory_order_relaxed);
+		}
+		item = source->item;
+		source->sequence.store(position + size, std::memory_order_release);
+		return true;
+	}
+
+	/*
+	 * returns the amount of items, only exact when no task
+	 * pushes or pops at the same time
+	 */
+	uint16_t getCount() {
+		uint32_t head = _head.load(std::memory_order_acquire);
+		uint32_t tail = _tail.load(std::memory_order_acquire);
+		return head - tail > size ? 0 : head - tail;
+	}
+
+	/*
+	 * returns the size of the queue
+	 */
+	uint16_t getSize() {
+		return size;
+	}
+
+private:
+	struct cell {
+		std::atomic<uint32_t> sequence;
+		T item;
+	};
+	cell _cells[size];
+	alignas(64) std::atomic<uint32_t> _head;
+	alignas(64) std::atomic<uint32_t> _tail;
+};
+
+#endif //  HX711QUEUE_H
@@ -0,0 +1,105 @@
+#include "HX711Reporter.h"
+
+/*
+ * Makes a reporter that decides when a value is worth sending.
+ * While the value is idle it is only reported when it moves more than
+ * the deadband away from the last reported value or when the heartbeat
+ * interval in millis expires. Once the deadband is exceeded the value is
+ * moving and every change larger than the hysteresis is reported until
+ * the value stays within the hysteresis, so real changes are reported
+ * without delay and small noise around the deadband does not chatter.
+ * deadband, hysteresis and heartbeat are optional and default to
+ * 2, 1 and 10000 ms, a heartbeat of 0 disables it.
+ */
+
+HX711Reporter::HX711Reporter(int32_t deadband, int32_t hysteresis,
+		uint32_t heartbeat) {
+	_deadband = deadband;
+	_hysteresis = hysteresis;
+	_heartbeat = heartbeat;
+	_reported = 0;
+	_lastReport = 0;
+	_started = false;
+	_moving = false;
+}
+
+/*
+ * returns true when the value must be reported, now is the time in millis
+ * the first value is always reported
+ */
+bool HX711Reporter::check(int32_t value, uint32_t now) {
+	int32_t change = value - _reported;
+
+	if (change < 0)
+		change = -change;
+	if (!_started) {
+		_started = true;
+	} else if (_moving ? change > _hysteresis : change > _deadband) {
+		_moving = true;
+	} else {
+		_moving = false;
+		if (!_heartbeat || (now - _lastReport) < _heartbeat)
+			return false;
+	}
+	_reported = value;
+	_lastReport = now;
+	return true;
+}
+
+/*
+ * returns the last reported value
+ */
+int32_t HX711Reporter::getReported() {
+	return _reported;
+}
+
+/*
+ * returns true when the value changed more than the hysteresis
+ * since the previous report
+ */
+bool HX711Reporter::isMoving() {
+	return _moving;
+}
+
+/*
+ * sets the change required to report an idle value
+ */
+void HX711Reporter::setDeadband(int32_t deadband) {
+	_deadband = deadband;
+}
+
+/*
+ * returns the deadband
+ */
+int32_t HX711Reporter::getDeadband() {
+	return _deadband;
+}
+
+/*
+ * sets the change required to keep reporting a moving value
+ */
+void HX711Reporter::setHysteresis(int32_t hysteresis) {
+	_hysteresis = hysteresis;
+}
+
+/*
+ * returns the hysteresis
+ */
+int32_t HX711Reporter::getHysteresis() {
+	return _hysteresis;
+}
+
+/*
+ * sets the maximum interval in millis between two reports,
+ * 0 disables the heartbeat
+ */
+void HX711Reporter::setHeartbeat(uint32_t heartbeat) {
+	_heartbeat = heartbeat;
+}
+
+/*
+ * returns the heartbeat interval
+ */
+uint32_t HX711Reporter::getHeartbeat() {
+	return _heartbeat;
+}
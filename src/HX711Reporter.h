@@ -0,0 +1,51 @@
+#ifndef HX711REPORTER_H
+#define HX711REPORTER_H
+
+/*
+ * Report on change with a deadband for the SimpleHX711 library.
+ *
+ * Copyright (C) 2016 Edwin Croissant
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * See the README.md file for additional information.
+ */
+
+#include "Arduino.h"
+
+class HX711Reporter {
+public:
+	HX711Reporter(int32_t deadband = 2, int32_t hysteresis = 1,
+			uint32_t heartbeat = 10000);
+	bool check(int32_t value, uint32_t now);
+	int32_t getReported();
+	bool isMoving();
+	void setDeadband(int32_t deadband);
+	int32_t getDeadband();
+	void setHysteresis(int32_t hysteresis);
+	int32_t getHysteresis();
+	void setHeartbeat(uint32_t heartbeat);
+	uint32_t getHeartbeat();
+
+private:
+	int32_t _deadband;
+	int32_t _hysteresis;
+	uint32_t _heartbeat;
+	int32_t _reported;
+	uint32_t _lastReport;
+	bool _started;
+	bool _moving;
+};
+
+#endif //  HX711REPORTER_H
@@ -0,0 +1,307 @@
+#include "HX711Rice.h"
+
+/*
+ * the most bits a sample can take: two escapes of HX711RICE_LIMIT ones,
+ * a flag and 32 bits
+ */
+#define HX711RICE_MAXBITS (2 * (HX711RICE_LIMIT + 1 + 32))
+
+/*
+ * maps small negative and positive numbers to small unsigned numbers
+ * 0, -1, 1, -2, 2 ... becomes 0, 1, 2, 3, 4 ...
+ */
+static uint32_t zigZag(uint32_t value) {
+	return (value << 1) ^ (0 - (value >> 31));
+}
+
+static uint32_t unZigZag(uint32_t value) {
+	return (value >> 1) ^ (0 - (value & 1));
+}
+
+/*
+ * starts with a Rice parameter of 4
+ */
+void HX711RiceState::begin() {
+	sum = 16;
+	count = 1;
+}
+
+/*
+ * returns the Rice parameter, the smallest k for which
+ * 2^k times the count is at least the sum
+ */
+uint8_t HX711RiceState::parameter() {
+	uint8_t k = 0;
+	while ((uint32_t(count) << k) < sum && k < HX711RICE_LIMIT)
+		++k;
+	return k;
+}
+
+/*
+ * adds a coded value to the running mean, halving the sum and count
+ * every 32 values so the parameter follows changes in the noise
+ */
+void HX711RiceState::update(uint32_t value) {
+	sum += value < 0xFFFFFF ? value : 0xFFFFFF;
+	if (++count >= 32) {
+		sum >>= 1;
+		count >>= 1;
+	}
+}
+
+/*
+ * Makes an encoder that writes one block in the buffer of size bytes.
+ * shift is optional and defaults to 8, the amount of zero bits on the
+ * right of the raw readings of SimpleHX711
+ */
+
+HX711RiceEncoder::HX711RiceEncoder(uint8_t *buffer, uint16_t size,
+		uint8_t shift) {
+	_buffer = buffer;
+	_size = size;
+	_shift = shift < 31 ? shift : 31;
+	begin();
+}
+
+/*
+ * starts a new block
+ */
+void HX711RiceEncoder::begin() {
+	_bit = HX711RICE_HEADER * 8;
+	_count = 0;
+	_timestamp = 0;
+	_delta = 0;
+	_raw = 0;
+	_timestampState.begin();
+	_rawState.begin();
+}
+
+/*
+ * writes the lowest bits of the value, most significant bit first
+ */
+void HX711RiceEncoder::putBits(uint32_t value, uint8_t bits) {
+	uint8_t free, take;
+
+	while (bits) {
+		free = 8 - (_bit & 7);
+		take = bits < free ? bits : free;
+		bits -= take;
+		if (free == 8)
+			_buffer[_bit >> 3] = 0;
+		_buffer[_bit >> 3] |= ((value >> bits) & ((1 << take) - 1))
+				<< (free - take);
+		_bit += take;
+	}
+}
+
+/*
+ * writes the value as a Rice code: the value shifted right by the
+ * parameter in unary followed by the bits shifted out. Large values
+ * are written as HX711RICE_LIMIT ones, a zero flag and 32 bits
+ */
+void HX711RiceEncoder::putRice(uint32_t value, HX711RiceState &state) {
+	uint8_t k = state.parameter();
+	uint32_t quotient = value >> k;
+
+	if (quotient < HX711RICE_LIMIT) {
+		putBits(((uint32_t(1) << quotient) - 1) << 1, quotient + 1);
+		putBits(value, k);
+	} else {
+		putBits((uint32_t(1) << HX711RICE_LIMIT) - 1, HX711RICE_LIMIT);
+		putBits(0, 1);
+		putBits(value, 32);
+	}
+	state.update(value);
+}
+
+/*
+ * writes a raw reading as is, HX711RICE_LIMIT ones, a one flag and 32 bits
+ */
+void HX711RiceEncoder::putVerbatim(uint32_t value) {
+	putBits((uint32_t(1) << HX711RICE_LIMIT) - 1, HX711RICE_LIMIT);
+	putBits(1, 1);
+	putBits(value, 32);
+}
+
+/*
+ * adds a sample, returns false when the block is full
+ */
+bool HX711RiceEncoder::add(int32_t raw, uint32_t timestamp) {
+	uint32_t delta;
+
+	if (_bit + HX711RICE_MAXBITS > uint32_t(_size) * 8 || _count == 0xFFFF)
+		return false;
+
+	if (!_count) {
+		putBits(timestamp, 32);
+		putBits(raw, 32);
+	} else {
+		delta = timestamp - _timestamp;
+		putRice(zigZag(delta - _delta), _timestampState);
+		_delta = delta;
+		/*
+		 * the difference is taken on the shifted readings,
+		 * which is only lossless when the shifted out bits are zero
+		 */
+		if (raw & ((uint32_t(1) << _shift) - 1))
+			putVerbatim(raw);
+		else
+			putRice(zigZag(uint32_t(raw >> _shift) - uint32_t(_raw >> _shift)),
+					_rawState);
+	}
+	_timestamp = timestamp;
+	_raw = raw;
+	++_count;
+	return true;
+}
+
+/*
+ * completes the block, returns the amount of bytes used
+ */
+uint16_t HX711RiceEncoder::finish() {
+	_buffer[0] = _count;
+	_buffer[1] = _count >> 8;
+	_buffer[2] = _shift;
+	return (_bit + 7) >> 3;
+}
+
+/*
+ * returns the amount of samples in the block
+ */
+uint16_t HX711RiceEncoder::getCount() {
+	return _count;
+}
+
+/*
+ * returns the amount of bits used so far, including the header
+ */
+uint32_t HX711RiceEncoder::getBits() {
+	return _bit;
+}
+
+/*
+ * Makes a decoder for one block of size bytes made by HX711RiceEncoder
+ */
+
+HX711RiceDecoder::HX711RiceDecoder(const uint8_t *buffer, uint16_t size) {
+	_buffer = buffer;
+	_bits = uint32_t(size) * 8;
+	_count = size >= HX711RICE_HEADER ? buffer[0] | (buffer[1] << 8) : 0;
+	_shift = size >= HX711RICE_HEADER ? buffer[2] : 0;
+	_bit = HX711RICE_HEADER * 8;
+	_index = 0;
+	_timestamp = 0;
+	_delta = 0;
+	_raw = 0;
+	_timestampState.begin();
+	_rawState.begin();
+}
+
+/*
+ * returns the amount of samples in the block
+ */
+uint16_t HX711RiceDecoder::getCount() {
+	return _count;
+}
+
+/*
+ * reads bits, most significant bit first, the caller
+ * checks there are enough bits left
+ */
+uint32_t HX711RiceDecoder::getBits(uint8_t bits) {
+	uint32_t value = 0;
+	uint8_t available, take;
+
+	while (bits) {
+		available = 8 - (_bit & 7);
+		take = bits < available ? bits : available;
+		bits -= take;
+		value = (value << take)
+				| ((_buffer[_bit >> 3] >> (available - take))
+						& ((1 << take) - 1));
+		_bit += take;
+	}
+	return value;
+}
+
+/*
+ * reads ones until a zero or HX711RICE_LIMIT ones, a whole byte
+ * of ones is skipped at once
+ */
+uint8_t HX711RiceDecoder::getUnary() {
+	uint8_t ones = 0, byte;
+
+	while (ones < HX711RICE_LIMIT && _bit < _bits) {
+		if (!(_bit & 7) && _buffer[_bit >> 3] == 0xFF
+				&& ones + 8 <= HX711RICE_LIMIT) {
+			ones += 8;
+			_bit += 8;
+			continue;
+		}
+		byte = _buffer[_bit >> 3] << (_bit & 7);
+		++_bit;
+		if (!(byte & 0x80))
+			return ones;
+		++ones;
+	}
+	return ones;
+}
+
+/*
+ * reads a Rice code or an escape, returns false when the block
+ * runs out of bits
+ */
+bool HX711RiceDecoder::getRice(uint32_t &value, HX711RiceState &state,
+		bool &verbatim) {
+	uint8_t k = state.parameter();
+	uint8_t quotient = getUnary();
+
+	if (quotient >= HX711RICE_LIMIT) {
+		if (_bit + 33 > _bits)
+			return false;
+		verbatim = getBits(1);
+		value = getBits(32);
+		if (!verbatim)
+			state.update(value);
+		return true;
+	}
+	if (_bit + k > _bits)
+		return false;
+	verbatim = false;
+	value = (uint32_t(quotient) << k) | getBits(k);
+	state.update(value);
+	return true;
+}
+
+/*
+ * decodes the next sample, returns false when all samples are decoded
+ * or the block is damaged
+ */
+bool HX711RiceDecoder::next(HX711Sample &sample) {
+	uint32_t value;
+	bool verbatim;
+
+	if (_index >= _count)
+		return false;
+	if (!_index) {
+		if (_bit + 64 > _bits)
+			return false;
+		_timestamp = getBits(32);
+		_raw = getBits(32);
+	} else {
+		if (!getRice(value, _timestampState, verbatim) || verbatim)
+			return false;
+		_delta += unZigZag(value);
+		_timestamp += _delta;
+		if (!getRice(value, _rawState, verbatim))
+			return false;
+		if (verbatim)
+			_raw = value;
+		else
+			_raw = (uint32_t(_raw >> _shift) + unZigZag(value)) << _shift;
+	}
+	++_index;
+	sample.timestamp = _timestamp;
+	sample.raw = _raw;
+	return true;
+}
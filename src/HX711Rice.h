@@ -0,0 +1,101 @@
+#ifndef HX711RICE_H
+#define HX711RICE_H
+
+/*
+ * Lossless compression of sample blocks for the SimpleHX711 library.
+ *
+ * Copyright (C) 2016 Edwin Croissant
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * See the README.md file for additional information.
+ */
+
+#include <stdint.h>
+#include "HX711Sample.h"
+
+/*
+ * A block starts with the amount of samples (uint16_t, least significant
+ * byte first) and the shift, followed by a bit stream (most significant bit
+ * first) holding the first sample verbatim and for every next sample the
+ * zig-zag coded difference of the timestamp deltas and the zig-zag coded
+ * difference of the raw readings shifted right by shift bits, both as
+ * adaptive Rice codes. The raw readings of SimpleHX711 have 8 bits of
+ * zeros on the right so the default shift is 8, a reading with other bits
+ * set there is stored verbatim.
+ */
+#define HX711RICE_HEADER 3
+#define HX711RICE_LIMIT 24
+
+/*
+ * the running mean of the coded values which selects the Rice parameter,
+ * the encoder and the decoder update it in the same way
+ */
+struct HX711RiceState {
+	uint32_t sum;
+	uint8_t count;
+	void begin();
+	uint8_t parameter();
+	void update(uint32_t value);
+};
+
+class HX711RiceEncoder {
+public:
+	HX711RiceEncoder(uint8_t *buffer, uint16_t size, uint8_t shift = 8);
+	void begin();
+	bool add(int32_t raw, uint32_t timestamp);
+	uint16_t finish();
+	uint16_t getCount();
+	uint32_t getBits();
+
+private:
+	void putBits(uint32_t value, uint8_t bits);
+	void putRice(uint32_t value, HX711RiceState &state);
+	void putVerbatim(uint32_t value);
+	uint8_t *_buffer;
+	uint16_t _size;
+	uint8_t _shift;
+	uint32_t _bit;
+	uint16_t _count;
+	uint32_t _timestamp;
+	uint32_t _delta;
+	int32_t _raw;
+	HX711RiceState _timestampState;
+	HX711RiceState _rawState;
+};
+
+class HX711RiceDecoder {
+public:
+	HX711RiceDecoder(const uint8_t *buffer, uint16_t size);
+	uint16_t getCount();
+	bool next(HX711Sample &sample);
+
+private:
+	uint32_t getBits(uint8_t bits);
+	uint8_t getUnary();
+	bool getRice(uint32_t &value, HX711RiceState &state, bool &verbatim);
+	const uint8_t *_buffer;
+	uint32_t _bits;
+	uint8_t _shift;
+	uint32_t _bit;
+	uint16_t _count;
+	uint16_t _index;
+	uint32_t _timestamp;
+	uint32_t _delta;
+	int32_t _raw;
+	HX711RiceState _timestampState;
+	HX711RiceState _rawState;
+};
+
+#endif //  HX711RICE_H
@@ -0,0 +1,35 @@
+#ifndef HX711SAMPLE_H
+#define HX711SAMPLE_H
+
+/*
+ * Sample type shared by the SimpleHX711 library and its host tools.
+ *
+ * Copyright (C) 2016 Edwin Croissant
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * See the README.md file for additional information.
+ */
+
+#include <stdint.h>
+
+/*
+ * a raw reading with the timestamp of the start of its conversion
+ */
+struct HX711Sample {
+	uint32_t timestamp;
+	int32_t raw;
+};
+
+#endif //  HX711SAMPLE_H
@@ -0,0 +1,146 @@
+/*
+ * AVR has no <atomic>, the sampler is for ESP32, ARM and host targets
+ */
+#ifndef __AVR__
+
+#include "HX711Sampler.h"
+
+/*
+ * Makes a sampler, policy is optional and defaults to dropOldest.
+ * The sampler task calls service whenever a scale signals a ready
+ * conversion (DOUT low), the consumer tasks call pop
+ */
+
+HX711Sampler::HX711Sampler(policy policy) {
+	_count = 0;
+	_policy = policy;
+	_blocked = false;
+	_dropped.store(0, std::memory_order_relaxed);
+}
+
+/*
+ * adds a scale, only the sampler task may read it from now on.
+ * Returns false when HX711SAMPLER_SCALES scales are added already
+ */
+bool HX711Sampler::add(SimpleHX711 &scale) {
+	if (_count >= HX711SAMPLER_SCALES)
+		return false;
+	_scales[_count++] = &scale;
+	return true;
+}
+
+/*
+ * queues the record according to the policy,
+ * returns false when it must wait for room
+ */
+bool HX711Sampler::queue(const HX711SamplerRecord &record) {
+	HX711SamplerRecord oldest;
+
+	if (_queue.push(record))
+		return true;
+	switch (_policy) {
+	case dropOldest:
+		/*
+		 * a consumer may pop in between, so try again until it fits
+		 */
+		do {
+			if (_queue.pop(oldest))
+				_dropped.fetch_add(1, std::memory_order_relaxed);
+		} while (!_queue.push(record));
+		return true;
+	case dropNewest:
+		_dropped.fetch_add(1, std::memory_order_relaxed);
+		return true;
+	default:
+		return false;
+	}
+}
+
+/*
+ * reads every scale once and queues the valid readings, call it from
+ * the sampler task when a scale is ready. With the block policy and a
+ * full queue nothing is read, call it again when a consumer made room.
+ * Returns the amount of records queued
+ */
+uint8_t HX711Sampler::service() {
+	HX711SamplerRecord record;
+	uint8_t i, queued = 0;
+
+	if (_blocked) {
+		if (!queue(_pending))
+			return 0;
+		_blocked = false;
+		++queued;
+	}
+	for (i = 0; i < _count; ++i) {
+		if (!_scales[i]->read() || _scales[i]->getStatus() != SimpleHX711::valid)
+			continue;
+		record.scale = i;
+		record.sample.timestamp = _scales[i]->getTimestamp();
+		record.sample.raw = _scales[i]->getRaw();
+		if (!queue(record)) {
+			/*
+			 * keep it for the next call, the scales after it are
+			 * read then, their chips hold the conversion until then
+			 */
+			_pending = record;
+			_blocked = true;
+			break;
+		}
+		++queued;
+	}
+	return queued;
+}
+
+/*
+ * takes the oldest record, any task may call it.
+ * Returns false when the queue is empty
+ */
+bool HX711Sampler::pop(HX711SamplerRecord &record) {
+	return _queue.pop(record);
+}
+
+/*
+ * returns true when the block policy stopped the reading
+ */
+bool HX711Sampler::isBlocked() {
+	return _blocked;
+}
+
+/*
+ * returns the amount of scales
+ */
+uint8_t HX711Sampler::getScales() {
+	return _count;
+}
+
+/*
+ * returns the amount of records in the queue
+ */
+uint16_t HX711Sampler::getQueued() {
+	return _queue.getCount();
+}
+
+/*
+ * returns the amount of readings dropped by the dropOldest
+ * and dropNewest policies
+ */
+uint32_t HX711Sampler::getDropped() {
+	return _dropped.load(std::memory_order_relaxed);
+}
+
+/*
+ * sets the policy for a full queue
+ */
+void HX711Sampler::setPolicy(policy policy) {
+	_policy = policy;
+}
+
+/*
+ * returns the policy
+ */
+HX711Sampler::policy HX711Sampler::getPolicy() {
+	return _policy;
+}
+
+#endif
@@ -0,0 +1,81 @@
+#ifndef HX711SAMPLER_H
+#define HX711SAMPLER_H
+
+/*
+ * Sampler that reads a set of scales in its own task or thread and hands
+ * the readings to consumers through a lock-free queue, on targets with
+ * <atomic> (not AVR).
+ *
+ * Copyright (C) 2016 Edwin Croissant
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * See the README.md file for additional information.
+ */
+
+#include <atomic>
+#include "HX711Queue.h"
+#include "HX711Sample.h"
+#include "SimpleHX711.h"
+
+/*
+ * the most scales of a sampler and the size of its queue (a power
+ * of two), they size the class so they are the same for the library
+ * and every sketch
+ */
+#define HX711SAMPLER_SCALES 8
+#define HX711SAMPLER_QUEUE 64
+
+/*
+ * a reading with the number of its scale, raw is getRaw()
+ */
+struct HX711SamplerRecord {
+	uint8_t scale;
+	HX711Sample sample;
+};
+
+class HX711Sampler {
+public:
+	/*
+	 * what happens to a reading when the queue is full:
+	 * dropOldest removes the oldest record to make room for it,
+	 * dropNewest drops the new reading and
+	 * block stops reading the scales until a consumer makes room
+	 */
+	enum policy {
+		dropOldest, dropNewest, block
+	};
+	HX711Sampler(policy policy = dropOldest);
+	bool add(SimpleHX711 &scale);
+	uint8_t service();
+	bool pop(HX711SamplerRecord &record);
+	bool isBlocked();
+	uint8_t getScales();
+	uint16_t getQueued();
+	uint32_t getDropped();
+	void setPolicy(policy policy);
+	policy getPolicy();
+
+private:
+	bool queue(const HX711SamplerRecord &record);
+	SimpleHX711 *_scales[HX711SAMPLER_SCALES];
+	uint8_t _count;
+	policy _policy;
+	HX711Queue<HX711SamplerRecord, HX711SAMPLER_QUEUE> _queue;
+	HX711SamplerRecord _pending;
+	bool _blocked;
+	std::atomic<uint32_t> _dropped;
+};
+
+#endif //  HX711SAMPLER_H
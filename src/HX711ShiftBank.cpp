@@ -0,0 +1,168 @@
+#include "HX711ShiftBank.h"
+#include "HX711Transpose.h"
+
+/*
+ * Makes a bank of count (1 to 32) HX711 chips with the shared clock
+ * on pinClk and the registers on pinLoad and spi. The gain is optional
+ * and defaults to gain128
+ */
+
+HX711ShiftBank::HX711ShiftBank(SPIClass &spi, uint8_t pinClk, uint8_t pinLoad,
+		uint8_t count, gain gain) :
+		_spi(spi) {
+	_pinClk = pinClk;
+	_pinLoad = pinLoad;
+	_count = count < HX711SHIFTBANK_LINES ? count : HX711SHIFTBANK_LINES;
+	_bytes = (_count + 7) / 8;
+	_mask = _count == 32 ? 0xFFFFFFFF : (uint32_t(1) << _count) - 1;
+	_gain = gain;
+	_spiClock = HX711SHIFTBANK_SPICLOCK;
+	memset(&_timing, 0, sizeof(_timing));
+}
+
+/*
+ * sets up the pins and SPI, returns false without chips. spiClock is
+ * the optional SPI clock of the register chain in Hz and defaults
+ * to 8 MHz
+ */
+bool HX711ShiftBank::begin(uint32_t spiClock) {
+	if (!_count)
+		return false;
+	_spiClock = spiClock;
+	pinMode(_pinClk, OUTPUT);
+	digitalWrite(_pinClk, LOW);
+	pinMode(_pinLoad, OUTPUT);
+	digitalWrite(_pinLoad, HIGH);
+	_spi.begin();
+	return true;
+}
+
+/*
+ * loads the data lines in the registers and shifts them in,
+ * bit 0 is the first data line
+ */
+uint32_t HX711ShiftBank::capture() {
+	uint32_t lines = 0;
+	uint8_t i;
+
+	/*
+	 * the registers shift on the rising edge of CLK, mode 2 samples on
+	 * the falling edge in between. The bus may be left in mode 0 by
+	 * SPI.begin() or another device, switching to mode 2 raises CLK so
+	 * the registers are loaded after that edge
+	 */
+	_spi.beginTransaction(SPISettings(_spiClock, MSBFIRST, SPI_MODE2));
+	digitalWrite(_pinLoad, LOW);
+	digitalWrite(_pinLoad, HIGH);
+	for (i = 0; i < _bytes; ++i)
+		lines |= uint32_t(_spi.transfer(0)) << (8 * i);
+	_spi.endTransaction();
+	return lines & _mask;
+}
+
+/*
+ * one clock pulse, returns its high time in us. An interrupt would
+ * make it longer so they wait until the falling edge
+ */
+uint16_t HX711ShiftBank::pulse() {
+	uint32_t start;
+
+	noInterrupts();
+	start = micros();
+	digitalWrite(_pinClk, HIGH);
+	digitalWrite(_pinClk, LOW);
+	start = micros() - start;
+	interrupts();
+	if (start > HX711SHIFTBANK_MAXHIGH && _timing.overruns < 255)
+		++_timing.overruns;
+	if (start > _timing.maxHigh)
+		_timing.maxHigh = start < 0xFFFF ? start : 0xFFFF;
+	return start;
+}
+
+/*
+ * returns a bit for every chip that has a conversion ready
+ * (its data line is low), bit 0 is the first data line
+ */
+uint32_t HX711ShiftBank::getReady() {
+	return ~capture() & _mask;
+}
+
+/*
+ * returns true when all chips have a conversion ready
+ */
+bool HX711ShiftBank::isReady() {
+	return _count && getReady() == _mask;
+}
+
+/*
+ * reads all chips at once, raw must have room for a reading per chip.
+ * Like SimpleHX711 the 24 bits are in the most significant bits.
+ * Returns false when a clock pulse took longer than 60 us,
+ * which may have powered the chips down
+ */
+bool HX711ShiftBank::read(int32_t *raw) {
+	uint32_t planes[24], start;
+	uint8_t bit, pulses;
+
+	memset(&_timing, 0, sizeof(_timing));
+	start = micros();
+	/*
+	 * the bit stays on the data lines until the next rising edge
+	 */
+	for (bit = 0; bit < 24; ++bit) {
+		pulse();
+		planes[bit] = capture();
+	}
+	pulses = _gain == gain128 ? 1 : (_gain == gain32 ? 2 : 3);
+	while (pulses--)
+		pulse();
+	HX711Transpose::toRaw(planes, _count, raw);
+	_timing.read = micros() - start;
+	return !_timing.overruns;
+}
+
+/*
+ * brings the chips in power down mode
+ */
+void HX711ShiftBank::powerDown() {
+	digitalWrite(_pinClk, LOW);
+	digitalWrite(_pinClk, HIGH);
+}
+
+/*
+ * powerUp will reset the chips, the gain is 128 for the first conversion
+ */
+void HX711ShiftBank::powerUp() {
+	digitalWrite(_pinClk, LOW);
+}
+
+/*
+ * possible values are gain128, gain64 (channel A) and gain32 (channel B)
+ * the new gain is selected by the next read and applies
+ * to the conversion after it
+ */
+void HX711ShiftBank::setGain(gain gain) {
+	_gain = gain;
+}
+
+/*
+ * returns the gain
+ */
+HX711ShiftBank::gain HX711ShiftBank::getGain() {
+	return _gain;
+}
+
+/*
+ * returns the amount of chips
+ */
+uint8_t HX711ShiftBank::getCount() {
+	return _count;
+}
+
+/*
+ * returns the timing of the last read
+ */
+HX711ShiftTiming HX711ShiftBank::getTiming() {
+	return _timing;
+}
@@ -0,0 +1,94 @@
+#ifndef HX711SHIFTBANK_H
+#define HX711SHIFTBANK_H
+
+/*
+ * Bank of up to 32 HX711 chips with a shared clock, the data lines
+ * are read with a chain of 74HC165 shift registers over SPI.
+ *
+ * Copyright (C) 2016 Edwin Croissant
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * See the README.md file for additional information.
+ */
+
+#include "Arduino.h"
+#include <SPI.h>
+
+/*
+ * the most data lines, four registers
+ */
+#define HX711SHIFTBANK_LINES 32
+
+/*
+ * the default SPI clock of the register chain in Hz
+ */
+#define HX711SHIFTBANK_SPICLOCK 8000000
+
+/*
+ * the clock must not be high for longer than 60 us or the chips power down
+ */
+#define HX711SHIFTBANK_MAXHIGH 60
+
+/*
+ * the timing of the last read in us
+ */
+struct HX711ShiftTiming {
+	uint16_t maxHigh;
+	uint32_t read;
+	uint8_t overruns;
+};
+
+/*
+ * The data line of chip 8 * n + i goes to input i (A is 0) of the nth
+ * register from the board, whose QH goes to MISO. The registers share
+ * SH/LD on pinLoad and CLK on SCK, CLK INH is low. After every clock
+ * pulse of the chips the registers load the data lines and SPI shifts
+ * them in, so the transfers don't count towards the 60 us limit
+ */
+class HX711ShiftBank {
+public:
+	enum gain {
+		gain32 = 32,
+		gain64 = 64,
+		gain128 = 128
+	};
+	HX711ShiftBank(SPIClass &spi, uint8_t pinClk, uint8_t pinLoad,
+			uint8_t count, gain gain = gain128);
+	bool begin(uint32_t spiClock = HX711SHIFTBANK_SPICLOCK);
+	uint32_t getReady();
+	bool isReady();
+	bool read(int32_t *raw);
+	void powerDown();
+	void powerUp();
+	void setGain(gain gain);
+	gain getGain();
+	uint8_t getCount();
+	HX711ShiftTiming getTiming();
+
+private:
+	uint32_t capture();
+	uint16_t pulse();
+	SPIClass &_spi;
+	uint8_t _pinClk;
+	uint8_t _pinLoad;
+	uint8_t _count;
+	uint8_t _bytes;
+	uint32_t _mask;
+	uint32_t _spiClock;
+	gain _gain;
+	HX711ShiftTiming _timing;
+};
+
+#endif //  HX711SHIFTBANK_H
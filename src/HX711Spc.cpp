@@ -0,0 +1,278 @@
+#include "HX711Spc.h"
+
+/*
+ * the control chart constants for subgroups of 2 to 10 items in
+ * thousandths: d2 estimates the standard deviation from the mean range,
+ * D3 and D4 give the limits of the R chart
+ */
+static const uint16_t d2[] = { 1128, 1693, 2059, 2326, 2534, 2704, 2847, 2970,
+		3078 };
+static const uint16_t D3[] = { 0, 0, 0, 0, 0, 76, 136, 184, 223 };
+static const uint16_t D4[] = { 3267, 2574, 2282, 2114, 2004, 1924, 1864, 1816,
+		1777 };
+
+/*
+ * counts the ones in the lowest bits of history
+ */
+static uint8_t ones(uint8_t history, uint8_t bits) {
+	uint8_t count = 0;
+
+	history &= (1 << bits) - 1;
+	while (history) {
+		history &= history - 1;
+		++count;
+	}
+	return count;
+}
+
+/*
+ * Makes a chart for subgroups of subgroupSize (2 to 10) items, the first
+ * baseline subgroups set the control limits. Both are optional and
+ * default to 5 and 25
+ */
+
+HX711Spc::HX711Spc(uint8_t subgroupSize, uint16_t baseline) {
+	_size = constrain(subgroupSize, 2, 10);
+	_baseline = baseline ? baseline : 1;
+	_lower = 0;
+	_upper = 0;
+	_specified = false;
+	reset();
+}
+
+/*
+ * forgets all subgroups and the control limits,
+ * the specification limits are kept
+ */
+void HX711Spc::reset() {
+	_count = 0;
+	_sum = 0;
+	_min = 0;
+	_max = 0;
+	_mean = 0;
+	_range = 0;
+	_subgroups = 0;
+	_sumItems = 0;
+	_sumRanges = 0;
+	_controlled = false;
+	_center = 0;
+	_meanRange = 0;
+	_violations = 0;
+	memset(_above, 0, sizeof(_above));
+	memset(_below, 0, sizeof(_below));
+}
+
+/*
+ * adds the weight of an item, returns true when it completes a subgroup,
+ * its mean, range and violations are then available
+ */
+bool HX711Spc::add(int32_t weight) {
+	if (!_count || weight < _min)
+		_min = weight;
+	if (!_count || weight > _max)
+		_max = weight;
+	_sum += weight;
+	if (++_count < _size)
+		return false;
+
+	/*
+	 * the sum of 10 weights or the range of two can pass the
+	 * int32_t range, for instance with HX711Weight::getRaw()
+	 */
+	_mean = float(_sum) / _size;
+	_range = uint32_t(_max) - uint32_t(_min);
+	_sumItems += _sum;
+	_sumRanges += _range;
+	++_subgroups;
+	_count = 0;
+	_sum = 0;
+
+	if (_controlled)
+		check(_mean, _range);
+	else if (_subgroups >= _baseline)
+		setControl(getGrandMean(), float(_sumRanges) / _subgroups);
+	return true;
+}
+
+/*
+ * checks a subgroup against the control limits. The zones are 1, 2 and 3
+ * standard deviations of the mean from the center, every zone has a
+ * history of 8 subgroups on each side, the newest in bit 0
+ */
+void HX711Spc::check(float mean, uint32_t range) {
+	float sigma = (getMeanUcl() - _center) / 3;
+	uint8_t zone;
+
+	for (zone = 0; zone < 3; ++zone) {
+		_above[zone] = (_above[zone] << 1)
+				| (mean > _center + zone * sigma ? 1 : 0);
+		_below[zone] = (_below[zone] << 1)
+				| (mean < _center - zone * sigma ? 1 : 0);
+	}
+	_violations = 0;
+	if (mean > getMeanUcl() || mean < getMeanLcl())
+		_violations |= beyondLimits;
+	/*
+	 * the rules count the points in a zone of the last 3, 5 and 8
+	 * subgroups, the newest must be one of them
+	 */
+	if (((_above[2] & 1) && ones(_above[2], 3) >= 2)
+			|| ((_below[2] & 1) && ones(_below[2], 3) >= 2))
+		_violations |= twoOfThree;
+	if (((_above[1] & 1) && ones(_above[1], 5) >= 4)
+			|| ((_below[1] & 1) && ones(_below[1], 5) >= 4))
+		_violations |= fourOfFive;
+	if (_above[0] == 0xFF || _below[0] == 0xFF)
+		_violations |= eightOnOneSide;
+	if (range > getRangeUcl() || range < getRangeLcl())
+		_violations |= rangeBeyondLimits;
+}
+
+/*
+ * sets the lower and upper specification limits for Cp and Cpk
+ */
+void HX711Spc::setSpecification(int32_t lower, int32_t upper) {
+	_lower = lower;
+	_upper = upper;
+	_specified = upper > lower;
+}
+
+/*
+ * sets the control limits from a known center and mean range, for
+ * instance those of an earlier run, instead of the baseline
+ */
+void HX711Spc::setControl(float center, float meanRange) {
+	_center = center;
+	_meanRange = meanRange;
+	_controlled = true;
+	_violations = 0;
+	memset(_above, 0, sizeof(_above));
+	memset(_below, 0, sizeof(_below));
+}
+
+/*
+ * returns true when the control limits are set
+ */
+bool HX711Spc::isControlled() {
+	return _controlled;
+}
+
+/*
+ * returns the rules the last subgroup violated, one bit per rule
+ */
+uint8_t HX711Spc::getViolations() {
+	return _violations;
+}
+
+/*
+ * returns the mean of the last subgroup
+ */
+float HX711Spc::getMean() {
+	return _mean;
+}
+
+/*
+ * returns the range of the last subgroup
+ */
+uint32_t HX711Spc::getRange() {
+	return _range;
+}
+
+/*
+ * returns the center line of the X-bar chart
+ */
+float HX711Spc::getCenter() {
+	return _center;
+}
+
+/*
+ * returns the upper control limit of the X-bar chart,
+ * 3 standard deviations of the mean above the center
+ */
+float HX711Spc::getMeanUcl() {
+	return _center
+			+ 3 * _meanRange * 1000 / d2[_size - 2] / sqrtf(_size);
+}
+
+/*
+ * returns the lower control limit of the X-bar chart
+ */
+float HX711Spc::getMeanLcl() {
+	return 2 * _center - getMeanUcl();
+}
+
+/*
+ * returns the center line of the R chart
+ */
+float HX711Spc::getMeanRange() {
+	return _meanRange;
+}
+
+/*
+ * returns the upper control limit of the R chart
+ */
+float HX711Spc::getRangeUcl() {
+	return _meanRange * D4[_size - 2] / 1000;
+}
+
+/*
+ * returns the lower control limit of the R chart,
+ * zero for subgroups of up to 6 items
+ */
+float HX711Spc::getRangeLcl() {
+	return _meanRange * D3[_size - 2] / 1000;
+}
+
+/*
+ * returns the mean of all items of all subgroups
+ */
+float HX711Spc::getGrandMean() {
+	return _subgroups ? float(_sumItems) / (uint64_t(_subgroups) * _size) : 0;
+}
+
+/*
+ * returns the standard deviation of the items estimated from the
+ * mean range of all subgroups
+ */
+float HX711Spc::getSigma() {
+	return _subgroups ?
+			float(_sumRanges) / _subgroups * 1000 / d2[_size - 2] : 0;
+}
+
+/*
+ * returns the potential capability, the width of the specification in
+ * 6 standard deviations. NAN without a specification or subgroups
+ */
+float HX711Spc::getCp() {
+	if (!_specified || !_subgroups)
+		return NAN;
+	return (float(_upper) - _lower) / (6 * getSigma());
+}
+
+/*
+ * returns the capability, the distance of the grand mean to the nearest
+ * specification limit in 3 standard deviations. NAN without a
+ * specification or subgroups
+ */
+float HX711Spc::getCpk() {
+	float mean = getGrandMean(), nearest;
+
+	if (!_specified || !_subgroups)
+		return NAN;
+	nearest = _upper - mean < mean - _lower ? _upper - mean : mean - _lower;
+	return nearest / (3 * getSigma());
+}
+
+/*
+ * returns the amount of complete subgroups
+ */
+uint32_t HX711Spc::getSubgroups() {
+	return _subgroups;
+}
+
+/*
+ * returns the amount of items per subgroup
+ */
+uint8_t HX711Spc::getSubgroupSize() {
+	return _size;
+}
@@ -0,0 +1,91 @@
+#ifndef HX711SPC_H
+#define HX711SPC_H
+
+/*
+ * Statistical process control of the weights of a checkweighing line:
+ * X-bar and R charts, Cp and Cpk and the Western Electric rules.
+ *
+ * Copyright (C) 2016 Edwin Croissant
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * See the README.md file for additional information.
+ */
+
+#include "Arduino.h"
+
+/*
+ * The weights of consecutive items form subgroups of 2 to 10 items. The
+ * first baseline subgroups set the control limits of the charts, after
+ * that every subgroup is checked against them. Cp and Cpk are running
+ * values over all subgroups against the specification limits, with the
+ * standard deviation estimated from the mean range. Only sums are kept,
+ * the memory does not grow with the amount of items
+ */
+class HX711Spc {
+public:
+	enum rule {
+		beyondLimits = 1,
+		twoOfThree = 2,
+		fourOfFive = 4,
+		eightOnOneSide = 8,
+		rangeBeyondLimits = 16
+	};
+	HX711Spc(uint8_t subgroupSize = 5, uint16_t baseline = 25);
+	void reset();
+	bool add(int32_t weight);
+	void setSpecification(int32_t lower, int32_t upper);
+	void setControl(float center, float meanRange);
+	bool isControlled();
+	uint8_t getViolations();
+	float getMean();
+	uint32_t getRange();
+	float getCenter();
+	float getMeanUcl();
+	float getMeanLcl();
+	float getMeanRange();
+	float getRangeUcl();
+	float getRangeLcl();
+	float getGrandMean();
+	float getSigma();
+	float getCp();
+	float getCpk();
+	uint32_t getSubgroups();
+	uint8_t getSubgroupSize();
+
+private:
+	void check(float mean, uint32_t range);
+	uint8_t _size;
+	uint16_t _baseline;
+	int32_t _lower;
+	int32_t _upper;
+	bool _specified;
+	uint8_t _count;
+	int64_t _sum;
+	int32_t _min;
+	int32_t _max;
+	float _mean;
+	uint32_t _range;
+	uint32_t _subgroups;
+	int64_t _sumItems;
+	int64_t _sumRanges;
+	bool _controlled;
+	float _center;
+	float _meanRange;
+	uint8_t _violations;
+	uint8_t _above[3];
+	uint8_t _below[3];
+};
+
+#endif //  HX711SPC_H
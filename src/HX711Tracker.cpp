@@ -0,0 +1,141 @@
+#include "HX711Tracker.h"
+
+/*
+ * Makes an alpha-beta tracker. Unlike the exponential smoothing in
+ * SimpleHX711 it estimates the rate of change too, so a ramping weight
+ * is followed without lag. alpha and beta are optional and
+ * default to 16384 and 2048, an input of 32768 gives 32768 / 65536 = 0.5
+ * Use setBandwidth to derive alpha and beta from the required bandwidth.
+ */
+
+HX711Tracker::HX711Tracker(uint16_t alpha, uint16_t beta) {
+	_alpha = alpha;
+	_beta = beta;
+	_interval = 0;
+	reset();
+}
+
+/*
+ * divides and rounds to the nearest integer
+ */
+static int32_t divRound(int64_t numerator, int64_t denominator) {
+	return numerator >= 0 ?
+			(numerator + denominator / 2) / denominator :
+			(numerator - denominator / 2) / denominator;
+}
+
+/*
+ * forget the tracked value and rate, the next update
+ * starts tracking again
+ */
+void HX711Tracker::reset() {
+	_started = false;
+	_value = 0;
+	_rate = 0;
+	_timestamp = 0;
+}
+
+/*
+ * updates the tracker with a reading, the timestamp is in millis
+ * as returned by SimpleHX711::getTimestamp()
+ */
+void HX711Tracker::update(int32_t value, uint32_t timestamp) {
+	int32_t predicted, residual;
+	uint32_t dt;
+
+	if (!_started) {
+		_value = value;
+		_rate = 0;
+		_timestamp = timestamp;
+		_started = true;
+		return;
+	}
+
+	dt = timestamp - _timestamp;
+	if (!dt)
+		dt = 1;
+	_timestamp = timestamp;
+	/*
+	 * keep track of the interval between readings in 1/16 ms
+	 * with a smoothing factor of 1/8
+	 */
+	if (_interval)
+		_interval += (int32_t(dt << 4) - int32_t(_interval)) / 8;
+	else
+		_interval = dt << 4;
+
+	predicted = _value + divRound(int64_t(_rate) * dt, 1000);
+	residual = value - predicted;
+	_value = predicted + divRound(int64_t(_alpha) * residual, 65536);
+	_rate += divRound(int64_t(_beta) * residual * 1000, int64_t(dt) << 16);
+}
+
+/*
+ * returns the tracked value
+ */
+int32_t HX711Tracker::getValue() {
+	return _value;
+}
+
+/*
+ * returns the tracked rate in units per second
+ */
+int32_t HX711Tracker::getRate() {
+	return _rate;
+}
+
+/*
+ * sets the gain of the value, an input of 32768 gives
+ * an alpha of 32768 / 65536 = 0.5
+ */
+void HX711Tracker::setAlpha(uint16_t alpha) {
+	_alpha = alpha;
+}
+
+/*
+ * returns the value of alpha
+ */
+uint16_t HX711Tracker::getAlpha() {
+	return _alpha;
+}
+
+/*
+ * sets the gain of the rate, an input of 32768 gives
+ * a beta of 32768 / 65536 = 0.5
+ */
+void HX711Tracker::setBeta(uint16_t beta) {
+	_beta = beta;
+}
+
+/*
+ * returns the value of beta
+ */
+uint16_t HX711Tracker::getBeta() {
+	return _beta;
+}
+
+/*
+ * sets alpha and beta for a critically damped tracker with the
+ * bandwidth in Hz. The dataRate in Hz is optional, when omitted the
+ * measured data rate is used, or 10 Hz when nothing is measured yet
+ */
+void HX711Tracker::setBandwidth(float bandwidth, float dataRate) {
+	float lambda, alpha, beta;
+
+	if (dataRate <= 0)
+		dataRate = getDataRate();
+	if (dataRate <= 0)
+		dataRate = 10;
+	lambda = exp(-2 * PI * bandwidth / dataRate);
+	alpha = 1 - lambda * lambda;
+	beta = (1 - lambda) * (1 - lambda);
+	_alpha = alpha >= 1 ? 65535 : uint16_t(alpha * 65536 + 0.5);
+	_beta = beta >= 1 ? 65535 : uint16_t(beta * 65536 + 0.5);
+}
+
+/*
+ * returns the measured data rate in Hz, 0 when not measured yet
+ */
+float HX711Tracker::getDataRate() {
+	return _interval ? 16000.0 / _interval : 0;
+}
@@ -0,0 +1,52 @@
+#ifndef HX711TRACKER_H
+#define HX711TRACKER_H
+
+/*
+ * Alpha-beta tracker estimating weight and weight rate for the
+ * SimpleHX711 library.
+ *
+ * Copyright (C) 2016 Edwin Croissant
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * See the README.md file for additional information.
+ */
+
+#include "Arduino.h"
+
+class HX711Tracker {
+public:
+	HX711Tracker(uint16_t alpha = 16384, uint16_t beta = 2048);
+	void reset();
+	void update(int32_t value, uint32_t timestamp);
+	int32_t getValue();
+	int32_t getRate();
+	void setAlpha(uint16_t alpha);
+	uint16_t getAlpha();
+	void setBeta(uint16_t beta);
+	uint16_t getBeta();
+	void setBandwidth(float bandwidth, float dataRate = 0);
+	float getDataRate();
+
+private:
+	uint16_t _alpha;
+	uint16_t _beta;
+	bool _started;
+	int32_t _value;
+	int32_t _rate;
+	uint32_t _timestamp;
+	uint32_t _interval;
+};
+
+#endif //  HX711TRACKER_H
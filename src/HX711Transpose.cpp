@@ -0,0 +1,92 @@
+#include "HX711Transpose.h"
+
+/*
+ * transposes an 8 by 8 bit matrix in place, bit j of row i becomes bit i
+ * of row j. Swaps the off diagonal blocks of 4, then of 2 and 1, 12 byte
+ * operations. On AVR the shift by 4 is a nibble swap
+ */
+void HX711Transpose::transpose8(uint8_t *rows) {
+	uint8_t mask = 0x0F, swap, width, row;
+
+	for (width = 4; width; width >>= 1, mask ^= mask << width)
+		for (row = 0; row < 8; row = (row + width + 1) & ~width) {
+			swap = ((rows[row] >> width) ^ rows[row + width]) & mask;
+			rows[row] ^= swap << width;
+			rows[row + width] ^= swap;
+		}
+}
+
+/*
+ * transposes a 32 by 32 bit matrix in place, bit j of row i becomes bit i
+ * of row j. Swaps the off diagonal blocks of 16, then of 8 in every block
+ * of 16 and so on, 5 rounds of 16 word operations instead of 1024 bits
+ */
+void HX711Transpose::transpose32(uint32_t *rows) {
+	uint32_t mask = 0x0000FFFF, swap;
+	uint8_t width, row;
+
+	for (width = 16; width; width >>= 1, mask ^= mask << width)
+		for (row = 0; row < 32; row = (row + width + 1) & ~width) {
+			swap = ((rows[row] >> width) ^ rows[row + width]) & mask;
+			rows[row] ^= swap << width;
+			rows[row + width] ^= swap;
+		}
+}
+
+/*
+ * converts the planes of count (up to 32) chips in blocks of 8 chips by
+ * 8 planes, every block gives one byte of the readings of 8 chips
+ */
+void HX711Transpose::toRaw8(const uint32_t *planes, uint8_t count,
+		int32_t *raw) {
+	uint8_t rows[8], first, byte, i;
+
+	for (first = 0; first < count && first < 32; first += 8) {
+		for (i = 0; i < 8 && first + i < count; ++i)
+			raw[first + i] = 0;
+		for (byte = 0; byte < 3; ++byte) {
+			/*
+			 * the first plane goes in row 7 so it ends up
+			 * in the most significant bit
+			 */
+			for (i = 0; i < 8; ++i)
+				rows[7 - i] = planes[8 * byte + i] >> first;
+			transpose8(rows);
+			for (i = 0; i < 8 && first + i < count; ++i)
+				raw[first + i] |= uint32_t(rows[i]) << (24 - 8 * byte);
+		}
+	}
+}
+
+/*
+ * converts the planes of count (up to 32) chips in one block of 32 by 32
+ * bits, plane i goes in row 31 - i and the last 8 rows are zero so the
+ * rows are the readings
+ */
+void HX711Transpose::toRaw32(const uint32_t *planes, uint8_t count,
+		int32_t *raw) {
+	uint32_t rows[32];
+	uint8_t i;
+
+	for (i = 0; i < 32; ++i)
+		rows[31 - i] = i < 24 ? planes[i] : 0;
+	transpose32(rows);
+	for (i = 0; i < count && i < 32; ++i)
+		raw[i] = rows[i];
+}
+
+/*
+ * converts the planes with the fastest kernel of the processor, a block
+ * of 32 by 32 bits takes as long for 1 chip as for 32
+ */
+void HX711Transpose::toRaw(const uint32_t *planes, uint8_t count,
+		int32_t *raw) {
+#ifdef __AVR__
+	toRaw8(planes, count, raw);
+#else
+	if (count <= 8)
+		toRaw8(planes, count, raw);
+	else
+		toRaw32(planes, count, raw);
+#endif
+}
@@ -0,0 +1,45 @@
+#ifndef HX711TRANSPOSE_H
+#define HX711TRANSPOSE_H
+
+/*
+ * Bit matrix transposition that turns the bit planes of a parallel read
+ * of HX711 chips into their readings.
+ *
+ * Copyright (C) 2016 Edwin Croissant
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * See the README.md file for additional information.
+ */
+
+#include <stdint.h>
+
+/*
+ * A bank clocks all chips at once and reads one bit of every chip per
+ * pulse, 24 planes with bit n for chip n, most significant bit first.
+ * toRaw turns them into readings with the 24 bits in the most
+ * significant bits like SimpleHX711. On AVR it works on blocks of 8 by 8
+ * bits with byte operations, elsewhere on one block of 32 by 32 bits
+ * unless there are at most 8 chips
+ */
+class HX711Transpose {
+public:
+	static void transpose8(uint8_t *rows);
+	static void transpose32(uint32_t *rows);
+	static void toRaw8(const uint32_t *planes, uint8_t count, int32_t *raw);
+	static void toRaw32(const uint32_t *planes, uint8_t count, int32_t *raw);
+	static void toRaw(const uint32_t *planes, uint8_t count, int32_t *raw);
+};
+
+#endif //  HX711TRANSPOSE_H
@@ -21,7 +21,13 @@ SimpleHX711::SimpleHX711(const uint8_t pinClk, const uint8_t pinData,
 	_pinData = pinData;
 	_gain = gain;
 	_tare = 0;
+	_zero = 0;
+	_net = 0;
+	_smoothedNet = 0;
+	_tareMode = noTare;
+	_tareDepth = 0;
 	_raw = 0;
+	_corrected = 0;
 	_smoothedRaw = 0;
 	_alpha = 200;
 	_adjuster = 256;
@@ -30,6 +36,10 @@ SimpleHX711::SimpleHX711(const uint8_t pinClk, const uint8_t pinData,
 	_status = init;
 	_readsUntilValid = readsUntilValid;
 	_timestamp = 0;
+	_onRead = NULL;
+	_corrector = NULL;
+	for (uint8_t i = 0; i < SIMPLEHX711_STREAMS; ++i)
+		setStream(i, _alpha, 0);
 }
 
 /*
@@ -38,6 +48,7 @@ SimpleHX711::SimpleHX711(const uint8_t pinClk, const uint8_t pinData,
  */
 bool SimpleHX711::read() {
 	int8_t i, j;
+	outputStream *stream;
 	/*
 	 * is the chip powered down?
 	 */
@@ -122,6 +133,11 @@ bool SimpleHX711::read() {
 	 * save the time for timedOut
 	 */
 	_conversionStartTime = millis();
+	/*
+	 * a correction like the hysteresis only depends on differences of the
+	 * load so it is done on the raw reading, _raw keeps the reading of the chip
+	 */
+	_corrected = _corrector ? _corrector->correct(_raw) : _raw;
 	/*
 	 * the amount of reads before a stable output depends
 	 * on the gain
@@ -130,18 +146,46 @@ bool SimpleHX711::read() {
 		++_readCount;
 		if (_readCount < (_readsUntilValid))
 			return false;
-		else
+		else {
 			/*
 			 * first valid read
 			 */
-			_smoothedRaw = _raw;
-	} else
+			_smoothedRaw = _corrected;
+			for (i = 0; i < SIMPLEHX711_STREAMS; ++i) {
+				_streams[i].smoothed = _corrected;
+				_streams[i].count = 0;
+			}
+		}
+	} else {
 		/*
 		 * exponential smoothing calculation
 		 */
-		_smoothedRaw += (_raw - _smoothedRaw) / 256 * _alpha;
+		_smoothedRaw += (_corrected - _smoothedRaw) / 256 * _alpha;
+		for (i = 0; i < SIMPLEHX711_STREAMS; ++i) {
+			stream = &_streams[i];
+			stream->smoothed += (_corrected - stream->smoothed) / 256
+					* stream->alpha;
+		}
+	}
+
+	/*
+	 * the streams are smoothed at the full data rate and
+	 * their output is updated at the decimated rate
+	 */
+	for (i = 0; i < SIMPLEHX711_STREAMS; ++i) {
+		stream = &_streams[i];
+		stream->updated = false;
+		if (stream->decimation && ++stream->count >= stream->decimation) {
+			stream->count = 0;
+			stream->output = stream->smoothed;
+			stream->updated = true;
+		}
+	}
 
+	updateNet();
 	_status = valid;
+	if (_onRead)
+		_onRead(*this);
 
 	return true;
 }
@@ -202,7 +246,9 @@ uint32_t SimpleHX711::getTimestamp() {
 }
 
 /*
- * returns the raw 32 bit reading from the sensor
+ * returns the raw 32 bit reading from the sensor, as read from the chip
+ * with the 24 bits in the MSB's. The smoothed reading, the net and the
+ * gross include the correction of setCorrector, this reading does not.
  * the boolean smoothed is optional and defaults to false
  */
 
@@ -211,11 +257,21 @@ int32_t SimpleHX711::getRaw(bool smoothed) {
 }
 
 /*
- * sets the tare to the raw reading
+ * caches the net readings, the gross readings are derived from them
+ */
+void SimpleHX711::updateNet() {
+	_net = _corrected - _zero - _tare;
+	_smoothedNet = _smoothedRaw - _zero - _tare;
+}
+
+/*
+ * sets the tare to the gross reading (the raw reading minus the zero)
  * the boolean smoothed is optional and defaults to false
  */
 void SimpleHX711::tare(bool smoothed) {
-	_tare = smoothed ? _smoothedRaw : _raw;
+	_tare = smoothed ? (_smoothedRaw - _zero) : (_corrected - _zero);
+	_tareMode = semiAutomaticTare;
+	updateNet();
 }
 
 /*
@@ -223,6 +279,8 @@ void SimpleHX711::tare(bool smoothed) {
  */
 void SimpleHX711::setTare(int32_t tare) {
 	_tare = tare;
+	_tareMode = tare ? semiAutomaticTare : noTare;
+	updateNet();
 }
 
 /*
@@ -233,11 +291,114 @@ int32_t SimpleHX711::getTare() {
 }
 
 /*
- * returns the raw 32 bits reading form the chip minus the tare
+ * sets the tare to a known value in adjusted units,
+ * for instance the weight of a container
+ */
+void SimpleHX711::setPresetTare(int32_t value) {
+	_tare = value * _adjuster;
+	_tareMode = presetTare;
+	updateNet();
+}
+
+/*
+ * removes the tare, the net reading equals the gross reading
+ */
+void SimpleHX711::clearTare() {
+	_tare = 0;
+	_tareMode = noTare;
+	updateNet();
+}
+
+/*
+ * returns how the tare was set
+ * noTare : there is no tare
+ * semiAutomaticTare : the tare is taken from a reading or set with setTare
+ * presetTare : the tare is set with setPresetTare
+ */
+SimpleHX711::tareMode SimpleHX711::getTareMode() {
+	return _tareMode;
+}
+
+/*
+ * saves the tare on the tare stack, the tare itself is not changed
+ * returns false when the stack is full
+ */
+bool SimpleHX711::pushTare() {
+	if (_tareDepth >= SIMPLEHX711_TARESTACK)
+		return false;
+	_tareStack[_tareDepth] = _tare;
+	_tareModeStack[_tareDepth] = _tareMode;
+	++_tareDepth;
+	return true;
+}
+
+/*
+ * restores the last saved tare from the tare stack
+ * returns false when the stack is empty
+ */
+bool SimpleHX711::popTare() {
+	if (!_tareDepth)
+		return false;
+	--_tareDepth;
+	_tare = _tareStack[_tareDepth];
+	_tareMode = tareMode(_tareModeStack[_tareDepth]);
+	updateNet();
+	return true;
+}
+
+/*
+ * returns the amount of tares on the tare stack
+ */
+uint8_t SimpleHX711::getTareDepth() {
+	return _tareDepth;
+}
+
+/*
+ * sets the gross zero to the raw reading
+ * the boolean smoothed is optional and defaults to false
+ */
+void SimpleHX711::zero(bool smoothed) {
+	_zero = smoothed ? _smoothedRaw : _corrected;
+	updateNet();
+}
+
+/*
+ * sets the value of the gross zero
+ */
+void SimpleHX711::setZero(int32_t zero) {
+	_zero = zero;
+	updateNet();
+}
+
+/*
+ * returns the value of the gross zero
+ */
+int32_t SimpleHX711::getZero() {
+	return _zero;
+}
+
+/*
+ * returns the raw 32 bits reading form the chip minus the zero and the tare
  * the boolean smoothed is optional and defaults to false
  */
 int32_t SimpleHX711::getRawMinusTare(bool smoothed) {
-	return smoothed ? (_smoothedRaw - _tare) : (_raw - _tare);
+	return smoothed ? _smoothedNet : _net;
+}
+
+/*
+ * returns the raw 32 bits reading form the chip minus the zero
+ * the boolean smoothed is optional and defaults to false
+ */
+int32_t SimpleHX711::getGross(bool smoothed) {
+	return (smoothed ? _smoothedNet : _net) + _tare;
+}
+
+/*
+ * returns an adjusted gross reading, the boolean smoothed
+ * is optional and defaults to false
+ */
+int32_t SimpleHX711::getGrossAdjusted(bool smoothed) {
+	return getGross(smoothed) / _adjuster;
 }
 
 /*
@@ -250,10 +411,7 @@ void SimpleHX711::adjustTo(int32_t value, bool smoothed) {
 	// prevent divide by zero
 	if (!value)
 		value = 1;
-	_adjuster =
-			smoothed ?
-					(_smoothedRaw - _tare) / value :
-					(_raw - _tare) / value;
+	_adjuster = (smoothed ? _smoothedNet : _net) / value;
 }
 
 /*
@@ -275,9 +433,23 @@ void SimpleHX711::setAdjuster(int32_t adjuster) {
  * is optional and defaults to false
  */
 int32_t SimpleHX711::getAdjusted(bool smoothed) {
-	return smoothed ?
-			(_smoothedRaw - _tare) / _adjuster :
-			(_raw - _tare) / _adjuster;
+	return (smoothed ? _smoothedNet : _net) / _adjuster;
+}
+
+/*
+ * returns the adjusted reading with 8 fractional bits, rounded instead
+ * of truncated. The boolean smoothed is optional and defaults to false
+ */
+HX711Weight SimpleHX711::getWeight(bool smoothed) {
+	return HX711Weight::fromRatio(smoothed ? _smoothedNet : _net, _adjuster);
+}
+
+/*
+ * returns the adjusted gross reading with 8 fractional bits,
+ * the boolean smoothed is optional and defaults to false
+ */
+HX711Weight SimpleHX711::getGrossWeight(bool smoothed) {
+	return HX711Weight::fromRatio(getGross(smoothed), _adjuster);
 }
 
 /*
@@ -314,3 +486,83 @@ uint8_t SimpleHX711::getReadsUntilValid() {
 	return _readsUntilValid;
 }
 
+/*
+ * configures one of the SIMPLEHX711_STREAMS output streams. Every stream
+ * has its own exponential smoothing with alpha (an input of 128 gives an
+ * alpha of 128 / 256 = 0.5) and its output is updated every decimation
+ * valid readings. The decimation is optional and defaults to 1,
+ * a decimation of 0 disables the stream
+ */
+void SimpleHX711::setStream(uint8_t stream, uint8_t alpha,
+		uint8_t decimation) {
+	if (stream >= SIMPLEHX711_STREAMS)
+		return;
+	_streams[stream].alpha = alpha;
+	_streams[stream].decimation = decimation;
+	_streams[stream].count = 0;
+	_streams[stream].updated = false;
+	_streams[stream].smoothed = _smoothedRaw;
+	_streams[stream].output = _smoothedRaw;
+}
+
+/*
+ * returns the alpha of the stream
+ */
+uint8_t SimpleHX711::getStreamAlpha(uint8_t stream) {
+	return stream < SIMPLEHX711_STREAMS ? _streams[stream].alpha : 0;
+}
+
+/*
+ * returns the decimation of the stream
+ */
+uint8_t SimpleHX711::getStreamDecimation(uint8_t stream) {
+	return stream < SIMPLEHX711_STREAMS ? _streams[stream].decimation : 0;
+}
+
+/*
+ * returns true when the output of the stream was updated by the last read
+ */
+bool SimpleHX711::isStreamUpdated(uint8_t stream) {
+	return stream < SIMPLEHX711_STREAMS ? _streams[stream].updated : false;
+}
+
+/*
+ * returns the raw 32 bit output of the stream
+ */
+int32_t SimpleHX711::getStream(uint8_t stream) {
+	return stream < SIMPLEHX711_STREAMS ? _streams[stream].output : 0;
+}
+
+/*
+ * returns the adjusted output of the stream
+ */
+int32_t SimpleHX711::getStreamAdjusted(uint8_t stream) {
+	return (getStream(stream) - _zero - _tare) / _adjuster;
+}
+
+/*
+ * returns the adjusted output of the stream with 8 fractional bits
+ */
+HX711Weight SimpleHX711::getStreamWeight(uint8_t stream) {
+	return HX711Weight::fromRatio(getStream(stream) - _zero - _tare, _adjuster);
+}
+
+/*
+ * sets a function that is called by read() after every valid reading,
+ * for instance to feed a capture buffer or a logger. NULL removes it
+ */
+void SimpleHX711::setOnRead(void (*onRead)(SimpleHX711 &scale)) {
+	_onRead = onRead;
+}
+
+/*
+ * sets a correction of every reading, for instance an HX711Hysteresis
+ * with its parameters in raw units. The net, the gross and the smoothed
+ * readings are corrected, getRaw() keeps returning the reading of the
+ * chip. NULL removes it
+ */
+void SimpleHX711::setCorrector(HX711Corrector *corrector) {
+	_corrector = corrector;
+	if (corrector)
+		corrector->reset();
+}
@@ -24,9 +24,29 @@
  * See the README.md file for additional information.
  * Revisions:
  * 08may2017 added getTimestamp and removed the 256 divisor in raw values
+ * 18oct2026 added output streams with their own smoothing and decimation
+ * 18oct2026 added gross zero, preset tare and a tare stack
+ * 18oct2026 added the onRead callback and HX711Sample
+ * 18oct2026 added getWeight, getGrossWeight and getStreamWeight
+ * 18oct2026 added setCorrector
  */
 
 #include "Arduino.h"
+#include "HX711Fixed.h"
+#include "HX711Corrector.h"
+#include "HX711Sample.h"
+
+/*
+ * the amount of output streams, it sizes the class so it is the same
+ * for the library and every sketch
+ */
+#define SIMPLEHX711_STREAMS 2
+
+/*
+ * the depth of the tare stack, it sizes the class so it is the same
+ * for the library and every sketch
+ */
+#define SIMPLEHX711_TARESTACK 4
 
 class SimpleHX711 {
 public:
@@ -38,6 +58,9 @@ public:
 	enum status {
 		init, valid, poweredDown, timedOut
 	};
+	enum tareMode {
+		noTare, semiAutomaticTare, presetTare
+	};
 	SimpleHX711(uint8_t pinClk, uint8_t pinData, byte readsUntilValid = 3, gain gain = gain128);
 	bool read();
 	status getStatus();
@@ -50,30 +73,72 @@ public:
 	void tare(bool smoothed = false);
 	void setTare(int32_t tare);
 	int32_t getTare();
+	void setPresetTare(int32_t value);
+	void clearTare();
+	tareMode getTareMode();
+	bool pushTare();
+	bool popTare();
+	uint8_t getTareDepth();
+	void zero(bool smoothed = false);
+	void setZero(int32_t zero);
+	int32_t getZero();
 	int32_t getRawMinusTare(bool smoothed = false);
+	int32_t getGross(bool smoothed = false);
+	int32_t getGrossAdjusted(bool smoothed = false);
 	void adjustTo(int32_t value, bool smoothed = false);
 	int32_t getAdjuster();
 	void setAdjuster(int32_t adjuster);
 	int32_t getAdjusted(bool smoothed = false);
+	HX711Weight getWeight(bool smoothed = false);
+	HX711Weight getGrossWeight(bool smoothed = false);
 	void powerDown();
 	void powerUp();
 	void setReadsUntilValid(uint8_t readsUntilValid);
 	uint8_t getReadsUntilValid();
+	void setStream(uint8_t stream, uint8_t alpha, uint8_t decimation = 1);
+	uint8_t getStreamAlpha(uint8_t stream);
+	uint8_t getStreamDecimation(uint8_t stream);
+	bool isStreamUpdated(uint8_t stream);
+	int32_t getStream(uint8_t stream);
+	int32_t getStreamAdjusted(uint8_t stream);
+	HX711Weight getStreamWeight(uint8_t stream);
+	void setOnRead(void (*onRead)(SimpleHX711 &scale));
+	void setCorrector(HX711Corrector *corrector);
 
 private:
+	void updateNet();
+	struct outputStream {
+		uint8_t alpha;
+		uint8_t decimation;
+		uint8_t count;
+		bool updated;
+		int32_t smoothed;
+		int32_t output;
+	};
 	uint8_t _pinClk;
 	uint8_t _pinData;
 	gain _gain;
 	int32_t _tare;
+	int32_t _zero;
+	int32_t _net;
+	int32_t _smoothedNet;
+	tareMode _tareMode;
+	int32_t _tareStack[SIMPLEHX711_TARESTACK];
+	uint8_t _tareModeStack[SIMPLEHX711_TARESTACK];
+	uint8_t _tareDepth;
 	uint8_t _alpha;
 	uint32_t _timestamp;
 	int32_t _raw;
+	int32_t _corrected;
 	int32_t _smoothedRaw;
 	int32_t _adjuster;
 	uint32_t _conversionStartTime;
 	status _status;
 	uint8_t _readCount;
 	uint8_t _readsUntilValid;
+	outputStream _streams[SIMPLEHX711_STREAMS];
+	void (*_onRead)(SimpleHX711 &scale);
+	HX711Corrector *_corrector;
 	};
 
 #endif //  SIMPLEHX711_H